@@ -0,0 +1,119 @@
+#include "common.hpp"
+
+#include <cstddef>
+
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/any_error.hpp>
+
+// Errors of two libraries propagated into a common error type, once through 'type_converter'
+// into an application error, once into 'any_error'.
+// The enum fits into the buffer of 'any_error', the message error ('bench::message_error') does not.
+// 'state.range(0)' is the share of failing calls in percent.
+
+namespace {
+enum class storage_error {
+    full = 1,
+};
+
+struct app_error {
+    int code;
+};
+}
+
+template <>
+struct rescpp::type_converter<storage_error, app_error> {
+    static constexpr app_error convert(const storage_error& error) noexcept {
+        return app_error{ static_cast<int>(error) };
+    }
+};
+
+template <>
+struct rescpp::type_converter<bench::message_error, app_error> {
+    static constexpr app_error convert(const bench::message_error&) noexcept {
+        return app_error{ -1 };
+    }
+};
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, storage_error> store(int value) {
+    if (value < 0) {
+        return rescpp::fail(storage_error::full);
+    }
+    return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> describe(int value) {
+    if (value < 0) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    return value + 1;
+}
+
+template <typename E>
+[[gnu::noinline]]
+rescpp::result<int, E> store_layer(int value) {
+    auto stored = RESCPP_TRY(store(value));
+    return stored * 2;
+}
+
+template <typename E>
+[[gnu::noinline]]
+rescpp::result<int, E> describe_layer(int value) {
+    auto described = RESCPP_TRY(describe(value));
+    return described * 2;
+}
+
+template <rescpp::result<int, app_error> (*Layer)(int)>
+void run_converted(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = static_cast<int>(call % 100) < state.range(0) ? -1 : static_cast<int>(call % 1000);
+        benchmark::DoNotOptimize(Layer(input));
+        ++call;
+    }
+}
+
+template <rescpp::result<int, rescpp::any_error> (*Layer)(int)>
+void run_any(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = static_cast<int>(call % 100) < state.range(0) ? -1 : static_cast<int>(call % 1000);
+        auto res = Layer(input);
+        if (res.has_error()) {
+            benchmark::DoNotOptimize(res.error().is<storage_error>());
+        }
+        benchmark::DoNotOptimize(res);
+        ++call;
+    }
+}
+
+void any_error_converted_enum(benchmark::State& state) {
+    run_converted<store_layer<app_error>>(state);
+}
+
+void any_error_erased_enum(benchmark::State& state) {
+    run_any<store_layer<rescpp::any_error>>(state);
+}
+
+void any_error_converted_message(benchmark::State& state) {
+    run_converted<describe_layer<app_error>>(state);
+}
+
+void any_error_erased_message(benchmark::State& state) {
+    run_any<describe_layer<rescpp::any_error>>(state);
+}
+
+void fail_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("fail_percent");
+    bench->Arg(0)->Arg(50)->Arg(100);
+}
+}
+
+BENCHMARK(any_error_converted_enum)->Apply(fail_args);
+BENCHMARK(any_error_erased_enum)->Apply(fail_args);
+BENCHMARK(any_error_converted_message)->Apply(fail_args);
+BENCHMARK(any_error_erased_message)->Apply(fail_args);
@@ -0,0 +1,92 @@
+#include "common.hpp"
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include <res-cpp/arena.hpp>
+
+// error storm, every operation of a request fails with a heap sized message,
+// which gets propagated through a few frames.
+// 'state.range(0)' errors per request, errors come from malloc or from one 'request_arena' per request
+
+namespace {
+struct pmr_error {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    std::pmr::string message;
+
+    pmr_error(std::string_view text, const allocator_type& alloc = {})
+        : message(text, alloc) {}
+
+    pmr_error(pmr_error&& other, const allocator_type& alloc)
+        : message(std::move(other.message), alloc) {}
+
+    pmr_error(pmr_error&&) noexcept = default;
+};
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> leaf_heap(int value) {
+    if (value >= 0) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    return value;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> operation_heap(int value) {
+    auto first = RESCPP_TRY(leaf_heap(value));
+    return first + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, pmr_error> leaf_arena(int value, const std::pmr::polymorphic_allocator<>& alloc) {
+    if (value >= 0) {
+        return rescpp::fail<pmr_error>(std::allocator_arg, alloc, bench::long_message);
+    }
+    return value;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, pmr_error> operation_arena(int value, const std::pmr::polymorphic_allocator<>& alloc) {
+    auto first = RESCPP_TRY(leaf_arena(value, alloc));
+    return first + 1;
+}
+
+void storm_heap(benchmark::State& state) {
+    const int errors = static_cast<int>(state.range(0));
+    bench::counters counters(state);
+    for (auto _ : state) {
+        for (int i = 0; i < errors; ++i) {
+            auto res = operation_heap(bench::opaque(i));
+            benchmark::DoNotOptimize(res);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * errors);
+}
+
+void storm_arena(benchmark::State& state) {
+    const int errors = static_cast<int>(state.range(0));
+    rescpp::request_arena<16 * 1024> arena;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const auto alloc = arena.allocator();
+        for (int i = 0; i < errors; ++i) {
+            auto res = operation_arena(bench::opaque(i), alloc);
+            benchmark::DoNotOptimize(res);
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(state.iterations() * errors);
+}
+
+void storm_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("errors");
+    bench->Arg(1)->Arg(16)->Arg(128);
+    bench->ThreadRange(1, 8);
+    bench->UseRealTime();
+}
+}
+
+BENCHMARK(storm_heap)->Apply(storm_args);
+BENCHMARK(storm_arena)->Apply(storm_args);
@@ -0,0 +1,71 @@
+#include "common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <res-cpp/res-cpp.hpp>
+
+// A parse loop over tokens longer than the small string buffer.
+// 'parse_fresh' returns a new 'result<std::string, E>' per token,
+// 'parse_reused' assigns every token into one result, which keeps the buffer of its string.
+// 'state.range(0)' is the share of invalid tokens in percent, an error in between costs one allocation.
+
+namespace {
+const std::array<std::string_view, 4> tokens = {
+    "first token which does not fit into the small string buffer",
+    "second token which does not fit into the small string buffer",
+    "third token which does not fit into the small string buffer",
+    "fourth token which does not fit into the small string buffer",
+};
+
+std::string_view token_for(const benchmark::State& state, std::size_t call) {
+    // an empty token is invalid
+    return static_cast<int>(call % 100) < state.range(0) ? std::string_view() : tokens[call % tokens.size()];
+}
+
+[[gnu::noinline]]
+rescpp::result<std::string, bench::error_code> parse_token(std::string_view token) {
+    if (token.empty()) {
+        return rescpp::fail(bench::error_code::failed);
+    }
+    return std::string(token);
+}
+
+[[gnu::noinline]]
+void parse_token_into(std::string_view token, rescpp::result<std::string, bench::error_code>& out) {
+    if (token.empty()) {
+        out = rescpp::fail(bench::error_code::failed);
+        return;
+    }
+    out = token;
+}
+
+void parse_fresh(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = parse_token(token_for(state, call++));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void parse_reused(benchmark::State& state) {
+    std::size_t call = 0;
+    rescpp::result<std::string, bench::error_code> res = rescpp::fail(bench::error_code::failed);
+    bench::counters counters(state);
+    for (auto _ : state) {
+        parse_token_into(token_for(state, call++), res);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void invalid_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("invalid_percent");
+    bench->Arg(0)->Arg(1)->Arg(50);
+}
+}
+
+BENCHMARK(parse_fresh)->Apply(invalid_args);
+BENCHMARK(parse_reused)->Apply(invalid_args);
@@ -0,0 +1,182 @@
+#include "common.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <res-cpp/batch.hpp>
+#include <res-cpp/result_vector.hpp>
+
+// batch status queries over 'state.range(0)' results with one error at the very end,
+// the obvious scalar loop over 'has_error()' against the kernels (runtime selected and forced scalar).
+// 'items_per_second' is elements per second, divide by 1e9 for elements/ns.
+
+namespace {
+using small_result = rescpp::result<int, int>;
+using large_result = rescpp::result<double, bench::message_error>;
+
+template <typename R, typename MakeValue, typename MakeError>
+std::vector<R> make_batch(std::size_t size, MakeValue make_value, MakeError make_error) {
+    std::vector<R> batch;
+    batch.reserve(size);
+    for (std::size_t i = 0; i + 1 < size; ++i) {
+        batch.push_back(make_value(i));
+    }
+    batch.push_back(make_error());
+    return batch;
+}
+
+std::vector<small_result> make_small(std::size_t size) {
+    return make_batch<small_result>(size,
+                                    [](std::size_t i) { return static_cast<int>(i); },
+                                    [] { return rescpp::fail(1); });
+}
+
+std::vector<large_result> make_large(std::size_t size) {
+    return make_batch<large_result>(size,
+                                    [](std::size_t i) { return static_cast<double>(i); },
+                                    [] { return rescpp::fail<bench::message_error>(bench::long_message); });
+}
+
+template <typename R>
+void count_errors_loop(benchmark::State& state, const std::vector<R>& batch) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (const auto& res : batch) {
+            count += res.has_error();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename R>
+void count_errors_kernel(benchmark::State& state, const std::vector<R>& batch, rescpp::batch_isa isa) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::count_errors(batch, isa));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename R>
+void first_error_loop(benchmark::State& state, const std::vector<R>& batch) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        std::size_t index = rescpp::no_error_index;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (batch[i].has_error()) {
+                index = i;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename R>
+void first_error_kernel(benchmark::State& state, const std::vector<R>& batch, rescpp::batch_isa isa) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::first_error_index(batch, isa));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void count_errors_small_loop(benchmark::State& state) {
+    count_errors_loop(state, make_small(static_cast<std::size_t>(state.range(0))));
+}
+
+void count_errors_small_scalar(benchmark::State& state) {
+    count_errors_kernel(state, make_small(static_cast<std::size_t>(state.range(0))), rescpp::batch_isa::scalar);
+}
+
+void count_errors_small_simd(benchmark::State& state) {
+    count_errors_kernel(state, make_small(static_cast<std::size_t>(state.range(0))), rescpp::detected_batch_isa());
+}
+
+void count_errors_large_loop(benchmark::State& state) {
+    count_errors_loop(state, make_large(static_cast<std::size_t>(state.range(0))));
+}
+
+void count_errors_large_simd(benchmark::State& state) {
+    count_errors_kernel(state, make_large(static_cast<std::size_t>(state.range(0))), rescpp::detected_batch_isa());
+}
+
+void first_error_small_loop(benchmark::State& state) {
+    first_error_loop(state, make_small(static_cast<std::size_t>(state.range(0))));
+}
+
+void first_error_small_simd(benchmark::State& state) {
+    first_error_kernel(state, make_small(static_cast<std::size_t>(state.range(0))), rescpp::detected_batch_isa());
+}
+
+void compact_small_loop(benchmark::State& state) {
+    const auto batch = make_small(static_cast<std::size_t>(state.range(0)));
+    std::vector<int> out(batch.size());
+    bench::counters counters(state);
+    for (auto _ : state) {
+        std::size_t written = 0;
+        for (const auto& res : batch) {
+            if (!res.has_error()) {
+                out[written++] = res.value();
+            }
+        }
+        benchmark::DoNotOptimize(written);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void compact_small_simd(benchmark::State& state) {
+    const auto batch = make_small(static_cast<std::size_t>(state.range(0)));
+    std::vector<int> out(batch.size());
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::compact_values(batch, out.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void count_errors_bitmap_loop(benchmark::State& state) {
+    rescpp::result_vector<int, int> batch;
+    for (const auto& res : make_small(static_cast<std::size_t>(state.range(0)))) {
+        batch.push_back(res);
+    }
+    bench::counters counters(state);
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            count += batch.has_error(i);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void count_errors_bitmap_simd(benchmark::State& state) {
+    rescpp::result_vector<int, int> batch;
+    for (const auto& res : make_small(static_cast<std::size_t>(state.range(0)))) {
+        batch.push_back(res);
+    }
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::count_errors(batch.error_bits()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+
+BENCHMARK(count_errors_small_loop)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_small_scalar)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_small_simd)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_large_loop)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_large_simd)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(first_error_small_loop)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(first_error_small_simd)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(compact_small_loop)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(compact_small_simd)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_bitmap_loop)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(count_errors_bitmap_simd)->Arg(4096)->Arg(1 << 20);
@@ -0,0 +1,116 @@
+#include "common.hpp"
+
+#include <cstddef>
+#include <iterator>
+
+#include <res-cpp/res-cpp.hpp>
+
+// Code size and instruction cache pressure of the try macros under the different
+// error branch hints ('RESCPP_TRY_ERROR_HINT').
+// Every hint gets 256 distinct functions with three try hops each, which are called round robin,
+// so their hot paths compete for the instruction cache.
+// 'state.range(0)' is the share of failing calls in percent.
+// 'code_bytes' is the size of the functions of one hint (ELF only, own section per hint).
+
+namespace {
+using chain_result = rescpp::result<int, bench::message_error>;
+using chain_function = chain_result (*)(int);
+
+[[gnu::noinline]]
+chain_result leaf(int value) {
+    if (value < 0) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    return value;
+}
+
+// the hint is expanded where 'RESCPP_TRY' is used, so it can be switched between the groups
+#define RESCPP_BENCH_CHAIN(hint, high, low) \
+    [[gnu::noinline, gnu::section("rescpp_bench_" #hint)]] \
+    chain_result hint##_chain_##high##low(int value) { \
+        auto first = RESCPP_TRY(leaf(value)); \
+        auto second = RESCPP_TRY(leaf(first + 0x##high##low)); \
+        auto third = RESCPP_TRY(leaf(second ^ 0x##high##low)); \
+        return third * 3 + 0x##high##low; \
+    }
+
+#define RESCPP_BENCH_CHAIN_ENTRY(hint, high, low) &hint##_chain_##high##low,
+
+#define RESCPP_BENCH_ROW(X, hint, high) \
+    X(hint, high, 0) X(hint, high, 1) X(hint, high, 2) X(hint, high, 3) \
+    X(hint, high, 4) X(hint, high, 5) X(hint, high, 6) X(hint, high, 7) \
+    X(hint, high, 8) X(hint, high, 9) X(hint, high, a) X(hint, high, b) \
+    X(hint, high, c) X(hint, high, d) X(hint, high, e) X(hint, high, f)
+
+#define RESCPP_BENCH_TABLE(X, hint) \
+    RESCPP_BENCH_ROW(X, hint, 0) RESCPP_BENCH_ROW(X, hint, 1) RESCPP_BENCH_ROW(X, hint, 2) RESCPP_BENCH_ROW(X, hint, 3) \
+    RESCPP_BENCH_ROW(X, hint, 4) RESCPP_BENCH_ROW(X, hint, 5) RESCPP_BENCH_ROW(X, hint, 6) RESCPP_BENCH_ROW(X, hint, 7) \
+    RESCPP_BENCH_ROW(X, hint, 8) RESCPP_BENCH_ROW(X, hint, 9) RESCPP_BENCH_ROW(X, hint, a) RESCPP_BENCH_ROW(X, hint, b) \
+    RESCPP_BENCH_ROW(X, hint, c) RESCPP_BENCH_ROW(X, hint, d) RESCPP_BENCH_ROW(X, hint, e) RESCPP_BENCH_ROW(X, hint, f)
+
+#undef RESCPP_TRY_ERROR_HINT
+#define RESCPP_TRY_ERROR_HINT [[unlikely]]
+RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN, unlikely)
+
+#undef RESCPP_TRY_ERROR_HINT
+#define RESCPP_TRY_ERROR_HINT [[likely]]
+RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN, likely)
+
+#undef RESCPP_TRY_ERROR_HINT
+#define RESCPP_TRY_ERROR_HINT
+RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN, none)
+
+constexpr chain_function unlikely_chains[] = { RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN_ENTRY, unlikely) };
+constexpr chain_function likely_chains[] = { RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN_ENTRY, likely) };
+constexpr chain_function none_chains[] = { RESCPP_BENCH_TABLE(RESCPP_BENCH_CHAIN_ENTRY, none) };
+}
+
+#if defined(__ELF__)
+// start and end of the sections, provided by the linker
+extern "C" const char __start_rescpp_bench_unlikely[], __stop_rescpp_bench_unlikely[];
+extern "C" const char __start_rescpp_bench_likely[], __stop_rescpp_bench_likely[];
+extern "C" const char __start_rescpp_bench_none[], __stop_rescpp_bench_none[];
+#endif
+
+namespace {
+template <std::size_t N>
+void run_chains(benchmark::State& state, const chain_function (&chains)[N], std::ptrdiff_t code_bytes) {
+    const int fail_percent = static_cast<int>(state.range(0));
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = static_cast<int>(call % 100) < fail_percent ? -1 : static_cast<int>(call);
+        auto res = chains[call % N](bench::opaque(input));
+        benchmark::DoNotOptimize(res);
+        ++call;
+    }
+    state.counters["code_bytes"] = static_cast<double>(code_bytes);
+}
+
+#if defined(__ELF__)
+#define RESCPP_BENCH_CODE_BYTES(hint) (__stop_rescpp_bench_##hint - __start_rescpp_bench_##hint)
+#else
+#define RESCPP_BENCH_CODE_BYTES(hint) 0
+#endif
+
+void try_hint_unlikely(benchmark::State& state) {
+    run_chains(state, unlikely_chains, RESCPP_BENCH_CODE_BYTES(unlikely));
+}
+
+void try_hint_likely(benchmark::State& state) {
+    run_chains(state, likely_chains, RESCPP_BENCH_CODE_BYTES(likely));
+}
+
+void try_hint_none(benchmark::State& state) {
+    run_chains(state, none_chains, RESCPP_BENCH_CODE_BYTES(none));
+}
+
+void fail_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("fail_percent");
+    bench->Arg(0)->Arg(1)->Arg(50);
+}
+}
+
+BENCHMARK(try_hint_unlikely)->Apply(fail_args);
+BENCHMARK(try_hint_likely)->Apply(fail_args);
+BENCHMARK(try_hint_none)->Apply(fail_args);
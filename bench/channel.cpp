@@ -0,0 +1,172 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <res-cpp/channel.hpp>
+
+// 'state.range(0)' threads, half producers and half consumers (one thread pushes and pops in turns),
+// pass 'items' timestamped results through 'result_channel' and a mutex protected deque of the same capacity.
+// Reports throughput and the 50th / 99th / 99.9th percentile of the push to pop latency in ns.
+
+namespace {
+constexpr std::size_t items = std::size_t(1) << 15;
+constexpr std::size_t queue_capacity = 1024;
+
+enum class stream_error {
+    end,
+};
+
+using stamped_result = rescpp::result<std::int64_t, stream_error>;
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// the queue used before, same interface as the channel
+class mutex_queue {
+    std::mutex mutex_;
+    std::deque<stamped_result> results_;
+    std::optional<stream_error> close_error_;
+
+public:
+    bool push(std::int64_t value) {
+        rescpp::detail::channel_backoff backoff;
+        while (true) {
+            {
+                std::lock_guard lock(mutex_);
+                if (close_error_.has_value()) {
+                    return false;
+                }
+                if (results_.size() < queue_capacity) {
+                    results_.emplace_back(std::in_place, value);
+                    return true;
+                }
+            }
+            backoff.wait();
+        }
+    }
+
+    stamped_result pop() {
+        rescpp::detail::channel_backoff backoff;
+        while (true) {
+            {
+                std::lock_guard lock(mutex_);
+                if (!results_.empty()) {
+                    stamped_result res = std::move(results_.front());
+                    results_.pop_front();
+                    return res;
+                }
+                if (close_error_.has_value()) {
+                    return rescpp::fail(*close_error_);
+                }
+            }
+            backoff.wait();
+        }
+    }
+
+    void close(stream_error error) {
+        std::lock_guard lock(mutex_);
+        close_error_ = error;
+    }
+};
+
+template <typename Queue>
+void pass_results(benchmark::State& state) {
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    const std::size_t producers = std::max<std::size_t>(threads / 2, 1);
+    const std::size_t consumers = std::max<std::size_t>(threads - producers, 1);
+    std::vector<std::int64_t> latencies;
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        Queue queue;
+        std::vector<std::vector<std::int64_t>> consumer_latencies(consumers);
+        for (auto& entry : consumer_latencies) {
+            entry.reserve(items / consumers + 1);
+        }
+
+        if (threads == 1) {
+            for (std::size_t done = 0; done < items; done += queue_capacity) {
+                for (std::size_t i = 0; i < queue_capacity; ++i) {
+                    queue.push(now());
+                }
+                for (std::size_t i = 0; i < queue_capacity; ++i) {
+                    consumer_latencies[0].push_back(now() - queue.pop().value());
+                }
+            }
+        }
+        else {
+            std::atomic<std::size_t> producers_left = producers;
+            std::vector<std::thread> workers;
+            for (std::size_t p = 0; p < producers; ++p) {
+                workers.emplace_back([&, p] {
+                    for (std::size_t i = p; i < items; i += producers) {
+                        queue.push(now());
+                    }
+                    if (--producers_left == 0) {
+                        queue.close(stream_error::end);
+                    }
+                });
+            }
+            for (std::size_t c = 0; c < consumers; ++c) {
+                workers.emplace_back([&, c] {
+                    for (auto res = queue.pop(); !res.has_error(); res = queue.pop()) {
+                        consumer_latencies[c].push_back(now() - res.value());
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        for (const auto& entry : consumer_latencies) {
+            latencies.insert(latencies.end(), entry.begin(), entry.end());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items));
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double fraction) {
+        return static_cast<double>(latencies[static_cast<std::size_t>(fraction * static_cast<double>(latencies.size() - 1))]);
+    };
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+}
+
+struct mpmc_channel : rescpp::result_channel<std::int64_t, stream_error> {
+    mpmc_channel()
+        : result_channel(queue_capacity) {}
+};
+
+struct spsc_channel : rescpp::spsc_result_channel<std::int64_t, stream_error> {
+    spsc_channel()
+        : result_channel(queue_capacity) {}
+};
+
+void channel_mpmc(benchmark::State& state) {
+    pass_results<mpmc_channel>(state);
+}
+
+void channel_spsc(benchmark::State& state) {
+    pass_results<spsc_channel>(state);
+}
+
+void channel_mutex(benchmark::State& state) {
+    pass_results<mutex_queue>(state);
+}
+}
+
+BENCHMARK(channel_spsc)->Arg(1)->Arg(2)->UseRealTime();
+BENCHMARK(channel_mpmc)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->UseRealTime();
+BENCHMARK(channel_mutex)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->UseRealTime();
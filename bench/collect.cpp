@@ -0,0 +1,89 @@
+#include "common.hpp"
+
+#include <ranges>
+#include <vector>
+
+#include <res-cpp/collect.hpp>
+
+// validation of a batch of 'state.range(0)' items, 'state.range(1)' puts an invalid item in the middle
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> validate(int value) {
+    if (value < 0) {
+        return rescpp::fail(bench::error_code::failed);
+    }
+    return value * 2;
+}
+
+std::vector<int> make_items(benchmark::State& state) {
+    std::vector<int> items(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+    }
+    if (state.range(1) != 0) {
+        items[items.size() / 2] = -1;
+    }
+    return items;
+}
+
+[[gnu::noinline]]
+rescpp::result<std::vector<int>, bench::error_code> validate_manual(const std::vector<int>& items) {
+    std::vector<int> output;
+    output.reserve(items.size());
+    for (const int item : items) {
+        auto value = RESCPP_TRY(validate(item));
+        output.push_back(value);
+    }
+    return output;
+}
+
+[[gnu::noinline]]
+rescpp::result<std::vector<int>, bench::error_code> validate_collect(const std::vector<int>& items) {
+    return rescpp::collect(items | std::views::transform(validate));
+}
+
+[[gnu::noinline]]
+rescpp::partitioned<int, bench::error_code> validate_partition(const std::vector<int>& items) {
+    return rescpp::partition(items | std::views::transform(validate));
+}
+
+void collect_manual(benchmark::State& state) {
+    const auto items = make_items(state);
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = validate_manual(items);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void collect_range(benchmark::State& state) {
+    const auto items = make_items(state);
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = validate_collect(items);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void collect_partition(benchmark::State& state) {
+    const auto items = make_items(state);
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto parts = validate_partition(items);
+        benchmark::DoNotOptimize(parts);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void batch_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({ "items", "fail" });
+    bench->ArgsProduct({ { 16, 1024, 16384 }, { 0, 1 } });
+}
+}
+
+BENCHMARK(collect_manual)->Apply(batch_args);
+BENCHMARK(collect_range)->Apply(batch_args);
+BENCHMARK(collect_partition)->Apply(batch_args);
@@ -0,0 +1,86 @@
+#ifndef RESCPP_BENCH_COMMON_H
+#define RESCPP_BENCH_COMMON_H
+
+#include <cstdint>
+#include <string>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#define RESCPP_BENCH_HAS_EXPECTED
+#endif
+
+#include <benchmark/benchmark.h>
+
+namespace bench {
+enum class error_code : std::int32_t {
+    none,
+    failed,
+};
+
+// heap owning error, long enough to skip the small string optimization
+struct message_error {
+    std::string message;
+};
+
+inline const char* const long_message = "something went wrong somewhere deep down in the stack";
+
+namespace detail {
+std::uint64_t read_instructions() noexcept;
+
+std::uint64_t read_l1i_misses() noexcept;
+
+std::uint64_t allocated_bytes() noexcept;
+
+std::uint64_t allocation_count() noexcept;
+}
+
+/// Reports per iteration counters for the lifetime of the object.
+/// - 'instructions' retired instructions (linux perf events, 0 when not available)
+/// - 'l1i_misses' level 1 instruction cache misses (linux perf events, 0 when not available)
+/// - 'bytes_allocated' bytes requested through global 'operator new'
+/// - 'allocations' calls to global 'operator new'
+class counters {
+    benchmark::State& state_;
+    std::uint64_t instructions_;
+    std::uint64_t l1i_misses_;
+    std::uint64_t bytes_;
+    std::uint64_t allocations_;
+
+public:
+    explicit counters(benchmark::State& state) noexcept
+        : state_(state),
+          instructions_(detail::read_instructions()),
+          l1i_misses_(detail::read_l1i_misses()),
+          bytes_(detail::allocated_bytes()),
+          allocations_(detail::allocation_count()) {}
+
+    ~counters() noexcept {
+        const auto instructions = detail::read_instructions() - instructions_;
+        const auto l1i_misses = detail::read_l1i_misses() - l1i_misses_;
+        const auto bytes = detail::allocated_bytes() - bytes_;
+        const auto allocations = detail::allocation_count() - allocations_;
+
+        state_.counters["instructions"] = benchmark::Counter(static_cast<double>(instructions),
+                                                             benchmark::Counter::kAvgIterations);
+        state_.counters["l1i_misses"] = benchmark::Counter(static_cast<double>(l1i_misses),
+                                                           benchmark::Counter::kAvgIterations);
+        state_.counters["bytes_allocated"] = benchmark::Counter(static_cast<double>(bytes),
+                                                                benchmark::Counter::kAvgIterations);
+        state_.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations),
+                                                            benchmark::Counter::kAvgIterations);
+    }
+
+    counters(const counters&) = delete;
+    counters& operator=(const counters&) = delete;
+};
+
+/// keeps the compiler from folding branches on the input
+template <typename T>
+inline T opaque(T value) noexcept {
+    benchmark::DoNotOptimize(value);
+    return value;
+}
+}
+
+#endif //RESCPP_BENCH_COMMON_H
@@ -0,0 +1,26 @@
+# Rebuilds the objects of 'TARGET' one unit at a time and fails if the average wall time per unit
+# is above 'BUDGET_MS', run by the 'res-cpp_compile_budget' target and the ctest of the same name.
+#
+#   cmake -DBUILD_DIR=<build> -DTARGET=<target> -DOBJECTS=<object|object|...> -DUNITS=<count> -DBUDGET_MS=<ms>
+#         -P check_budget.cmake
+
+string(REPLACE "|" ";" objects "${OBJECTS}")
+file(REMOVE ${objects})
+
+# '%s%f' are the microseconds since the epoch
+string(TIMESTAMP start "%s%f" UTC)
+execute_process(
+        COMMAND ${CMAKE_COMMAND} --build ${BUILD_DIR} --target ${TARGET} --parallel 1
+        RESULT_VARIABLE build_result
+)
+string(TIMESTAMP stop "%s%f" UTC)
+
+if (NOT build_result EQUAL 0)
+    message(FATAL_ERROR "building '${TARGET}' failed")
+endif ()
+
+math(EXPR unit_ms "(${stop} - ${start}) / 1000 / ${UNITS}")
+message(STATUS "${TARGET}: ${unit_ms} ms per unit, budget ${BUDGET_MS} ms")
+if (unit_ms GREATER BUDGET_MS)
+    message(FATAL_ERROR "${TARGET}: ${unit_ms} ms per unit exceeds the budget of ${BUDGET_MS} ms ('RESCPP_COMPILE_BENCH_BUDGET_MS')")
+endif ()
@@ -0,0 +1,132 @@
+#include "common.hpp"
+
+#include <stdexcept>
+
+#include <res-cpp/res-cpp.hpp>
+
+// construction of the returned object, 'state.range(0)' selects the error path
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> make_result(bool fail) {
+    if (fail) {
+        return rescpp::fail(bench::error_code::failed);
+    }
+    return 42;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> make_message_result(bool fail) {
+    if (fail) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    return 42;
+}
+
+[[gnu::noinline]]
+bench::error_code make_error_code(bool fail, int& out) {
+    if (fail) {
+        return bench::error_code::failed;
+    }
+    out = 42;
+    return bench::error_code::none;
+}
+
+[[gnu::noinline]]
+int make_throwing(bool fail) {
+    if (fail) {
+        throw std::runtime_error(bench::long_message);
+    }
+    return 42;
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+[[gnu::noinline]]
+std::expected<int, bench::error_code> make_expected(bool fail) {
+    if (fail) {
+        return std::unexpected(bench::error_code::failed);
+    }
+    return 42;
+}
+
+[[gnu::noinline]]
+std::expected<int, bench::message_error> make_message_expected(bool fail) {
+    if (fail) {
+        return std::unexpected(bench::message_error{ bench::long_message });
+    }
+    return 42;
+}
+#endif
+
+void construction_result(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = make_result(bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void construction_result_message(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = make_message_result(bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void construction_error_code(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int value = 0;
+        auto code = make_error_code(bench::opaque(fail), value);
+        benchmark::DoNotOptimize(code);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void construction_exception(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        try {
+            auto value = make_throwing(bench::opaque(fail));
+            benchmark::DoNotOptimize(value);
+        }
+        catch (const std::runtime_error& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+void construction_expected(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = make_expected(bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void construction_expected_message(benchmark::State& state) {
+    const bool fail = state.range(0) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = make_message_expected(bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+#endif
+}
+
+BENCHMARK(construction_result)->ArgName("fail")->Arg(0)->Arg(1);
+BENCHMARK(construction_result_message)->ArgName("fail")->Arg(0)->Arg(1);
+BENCHMARK(construction_error_code)->ArgName("fail")->Arg(0)->Arg(1);
+BENCHMARK(construction_exception)->ArgName("fail")->Arg(0)->Arg(1);
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+BENCHMARK(construction_expected)->ArgName("fail")->Arg(0)->Arg(1);
+BENCHMARK(construction_expected_message)->ArgName("fail")->Arg(0)->Arg(1);
+#endif
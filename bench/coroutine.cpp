@@ -0,0 +1,129 @@
+#include "common.hpp"
+
+#include <array>
+#include <memory>
+
+#include <res-cpp/coroutine.hpp>
+
+// propagation through 'state.range(0)' frames as coroutines compared to 'RESCPP_TRY',
+// 'state.range(1)' selects the error path
+
+namespace {
+/// Bump allocator over a fixed buffer, for frames which do not get elided.
+class frame_arena {
+    alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer_;
+    std::size_t used_ = 0;
+
+public:
+    void* allocate(std::size_t size) noexcept {
+        void* ptr = buffer_.data() + used_;
+        used_ += size;
+        return ptr;
+    }
+
+    void deallocate(std::size_t size) noexcept {
+        used_ -= size;
+    }
+};
+
+template <typename T>
+struct arena_allocator {
+    using value_type = T;
+
+    frame_arena* arena;
+
+    explicit arena_allocator(frame_arena* arena) noexcept
+        : arena(arena) {}
+
+    template <typename U>
+    explicit arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena(other.arena) {}
+
+    T* allocate(std::size_t count) noexcept {
+        return static_cast<T*>(arena->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T*, std::size_t count) noexcept {
+        arena->deallocate(count * sizeof(T));
+    }
+};
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> leaf(bool fail) {
+    if (fail) {
+        return rescpp::fail(bench::error_code::failed);
+    }
+    return 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> chain_try(int depth, bool fail) {
+    if (depth == 0) {
+        return leaf(fail);
+    }
+    auto value = RESCPP_TRY(chain_try(depth - 1, fail));
+    return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> chain_coroutine(int depth, bool fail) {
+    if (depth == 0) {
+        co_return leaf(fail);
+    }
+    auto value = co_await chain_coroutine(depth - 1, fail);
+    co_return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> chain_coroutine_arena(std::allocator_arg_t,
+                                                             const arena_allocator<std::byte>& alloc,
+                                                             int depth,
+                                                             bool fail) {
+    if (depth == 0) {
+        co_return leaf(fail);
+    }
+    auto value = co_await chain_coroutine_arena(std::allocator_arg, alloc, depth - 1, fail);
+    co_return value + 1;
+}
+
+void coroutine_try(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_try(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void coroutine_heap(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_coroutine(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void coroutine_arena(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    auto arena = std::make_unique<frame_arena>();
+    const arena_allocator<std::byte> alloc(arena.get());
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_coroutine_arena(std::allocator_arg, alloc, bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void depth_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({ "depth", "fail" });
+    bench->ArgsProduct({ { 1, 4, 16, 32 }, { 0, 1 } });
+}
+}
+
+BENCHMARK(coroutine_try)->Apply(depth_args);
+BENCHMARK(coroutine_heap)->Apply(depth_args);
+BENCHMARK(coroutine_arena)->Apply(depth_args);
@@ -0,0 +1,118 @@
+#include "common.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::atomic<std::uint64_t> allocated_bytes{ 0 };
+std::atomic<std::uint64_t> allocation_count{ 0 };
+
+#if defined(__linux__)
+class perf_counter {
+    int fd_ = -1;
+
+public:
+    perf_counter(std::uint32_t type, std::uint64_t config) noexcept {
+        perf_event_attr attr{};
+        attr.type = type;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ != -1) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    perf_counter(const perf_counter&) = delete;
+    perf_counter& operator=(const perf_counter&) = delete;
+
+    ~perf_counter() noexcept {
+        if (fd_ != -1) {
+            close(fd_);
+        }
+    }
+
+    std::uint64_t read() const noexcept {
+        std::uint64_t count = 0;
+        if (fd_ == -1 || ::read(fd_, &count, sizeof(count)) != sizeof(count)) {
+            return 0;
+        }
+        return count;
+    }
+};
+
+perf_counter instruction_counter() noexcept {
+    return perf_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+}
+
+perf_counter l1i_miss_counter() noexcept {
+    return perf_counter(PERF_TYPE_HW_CACHE,
+                        PERF_COUNT_HW_CACHE_L1I
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+#else
+class perf_counter {
+public:
+    std::uint64_t read() const noexcept {
+        return 0;
+    }
+};
+
+perf_counter instruction_counter() noexcept {
+    return {};
+}
+
+perf_counter l1i_miss_counter() noexcept {
+    return {};
+}
+#endif
+}
+
+void* operator new(std::size_t size) {
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace bench::detail {
+std::uint64_t read_instructions() noexcept {
+    static const perf_counter counter = instruction_counter();
+    return counter.read();
+}
+
+std::uint64_t read_l1i_misses() noexcept {
+    static const perf_counter counter = l1i_miss_counter();
+    return counter.read();
+}
+
+std::uint64_t allocated_bytes() noexcept {
+    return ::allocated_bytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t allocation_count() noexcept {
+    return ::allocation_count.load(std::memory_order_relaxed);
+}
+}
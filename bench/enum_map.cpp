@@ -0,0 +1,129 @@
+#include "common.hpp"
+
+#include <cstddef>
+
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/enum_map.hpp>
+
+// Conversion of an error enum at a layer boundary, a handwritten 'switch'
+// against 'enum_map' with a table (irregular mapping) and with an offset (same distance for every pair).
+// 'state.range(0)' is the share of failing calls in percent, every failing call converts its error.
+
+namespace {
+enum class driver_error {
+    timeout,
+    reset,
+    crc,
+    busy,
+    overflow,
+    removed,
+};
+
+enum class switched_error {
+    retry,
+    broken,
+    gone,
+};
+
+enum class table_error {
+    retry,
+    broken,
+    gone,
+};
+
+enum class offset_error {
+    none,
+    timeout,
+    reset,
+    crc,
+    busy,
+    overflow,
+    removed,
+};
+}
+
+template <>
+struct rescpp::type_converter<driver_error, switched_error> {
+    static constexpr switched_error convert(const driver_error& error) noexcept {
+        switch (error) {
+        case driver_error::timeout:
+        case driver_error::busy:
+            return switched_error::retry;
+        case driver_error::reset:
+        case driver_error::crc:
+        case driver_error::overflow:
+            return switched_error::broken;
+        case driver_error::removed:
+            return switched_error::gone;
+        }
+        return switched_error::broken;
+    }
+};
+
+template <>
+struct rescpp::type_converter<driver_error, table_error> : rescpp::enum_map<driver_error, table_error,
+    rescpp::enum_pair<driver_error::timeout, table_error::retry>,
+    rescpp::enum_pair<driver_error::reset, table_error::broken>,
+    rescpp::enum_pair<driver_error::crc, table_error::broken>,
+    rescpp::enum_pair<driver_error::busy, table_error::retry>,
+    rescpp::enum_pair<driver_error::overflow, table_error::broken>,
+    rescpp::enum_pair<driver_error::removed, table_error::gone>> {};
+
+template <>
+struct rescpp::type_converter<driver_error, offset_error> : rescpp::enum_map<driver_error, offset_error,
+    rescpp::enum_pair<driver_error::timeout, offset_error::timeout>,
+    rescpp::enum_pair<driver_error::reset, offset_error::reset>,
+    rescpp::enum_pair<driver_error::crc, offset_error::crc>,
+    rescpp::enum_pair<driver_error::busy, offset_error::busy>,
+    rescpp::enum_pair<driver_error::overflow, offset_error::overflow>,
+    rescpp::enum_pair<driver_error::removed, offset_error::removed>> {};
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, driver_error> transfer(int value) {
+    if (value < 0) {
+        return rescpp::fail(static_cast<driver_error>(-value % 6));
+    }
+    return value + 1;
+}
+
+template <typename E>
+[[gnu::noinline]]
+rescpp::result<int, E> transfer_layer(int value) {
+    auto sent = RESCPP_TRY(transfer(value));
+    return sent * 2;
+}
+
+template <typename E>
+void run_layer(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int value = static_cast<int>(call % 1000);
+        const int input = static_cast<int>(call % 100) < state.range(0) ? -value - 1 : value;
+        benchmark::DoNotOptimize(transfer_layer<E>(input));
+        ++call;
+    }
+}
+
+void enum_map_switch(benchmark::State& state) {
+    run_layer<switched_error>(state);
+}
+
+void enum_map_table(benchmark::State& state) {
+    run_layer<table_error>(state);
+}
+
+void enum_map_offset(benchmark::State& state) {
+    run_layer<offset_error>(state);
+}
+
+void fail_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("fail_percent");
+    bench->Arg(0)->Arg(50)->Arg(100);
+}
+}
+
+BENCHMARK(enum_map_switch)->Apply(fail_args);
+BENCHMARK(enum_map_table)->Apply(fail_args);
+BENCHMARK(enum_map_offset)->Apply(fail_args);
@@ -0,0 +1,119 @@
+#include "common.hpp"
+
+#include <stdexcept>
+
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/exception.hpp>
+
+// Cost of the exception bridge at an API boundary.
+// 'catch_as_result' against the same call with a handwritten 'try'/'catch' and without any handler,
+// 'value_or_throw' against 'value()' after a check.
+// 'state.range(0)' is the share of throwing calls (or results with errors) in percent.
+
+namespace {
+enum class boundary_error {
+    out_of_range,
+    unknown,
+};
+
+[[gnu::noinline]]
+int throwing_call(int value) {
+    if (value < 0) {
+        throw std::out_of_range("negative");
+    }
+    return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, boundary_error> result_call(int value) {
+    if (value < 0) {
+        return rescpp::fail(boundary_error::out_of_range);
+    }
+    return value + 1;
+}
+
+int input_for(const benchmark::State& state, std::size_t call) {
+    return static_cast<int>(call % 100) < state.range(0) ? -1 : static_cast<int>(call % 1000);
+}
+
+void catch_as_result(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = input_for(state, call++);
+        benchmark::DoNotOptimize(rescpp::catch_as_result<boundary_error>(
+            [input] { return throwing_call(input); },
+            [](const std::out_of_range&) { return boundary_error::out_of_range; },
+            [] { return boundary_error::unknown; }));
+    }
+}
+
+rescpp::result<int, boundary_error> handwritten_boundary(int input) {
+    try {
+        return throwing_call(input);
+    }
+    catch (const std::out_of_range&) {
+        return rescpp::fail(boundary_error::out_of_range);
+    }
+    catch (...) {
+        return rescpp::fail(boundary_error::unknown);
+    }
+}
+
+void handwritten_catch(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handwritten_boundary(input_for(state, call++)));
+    }
+}
+
+void no_handler(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        // never throws, the baseline for the non throwing path
+        const int input = input_for(state, call++) & 0x7fffffff;
+        benchmark::DoNotOptimize(throwing_call(input));
+    }
+}
+
+void value_or_throw(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = input_for(state, call++);
+        try {
+            benchmark::DoNotOptimize(rescpp::value_or_throw(result_call(input)));
+        }
+        catch (const rescpp::error_exception<boundary_error>& ex) {
+            benchmark::DoNotOptimize(ex.error());
+        }
+    }
+}
+
+void checked_value(benchmark::State& state) {
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = input_for(state, call++);
+        auto res = result_call(input);
+        if (res.has_error()) {
+            benchmark::DoNotOptimize(res.error());
+            continue;
+        }
+        benchmark::DoNotOptimize(res.value());
+    }
+}
+
+void throw_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("throw_percent");
+    bench->Arg(0)->Arg(1)->Arg(50);
+}
+}
+
+BENCHMARK(catch_as_result)->Apply(throw_args);
+BENCHMARK(handwritten_catch)->Apply(throw_args);
+BENCHMARK(no_handler)->Arg(0);
+BENCHMARK(value_or_throw)->Apply(throw_args);
+BENCHMARK(checked_value)->Apply(throw_args);
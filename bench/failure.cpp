@@ -0,0 +1,114 @@
+#include "common.hpp"
+
+#include <res-cpp/res-cpp.hpp>
+
+// 'failure' -> 'result' conversion, same error type and converted through 'type_converter'
+
+namespace {
+enum class other_error_code : std::int32_t {
+    none,
+    failed,
+};
+}
+
+template <>
+struct rescpp::type_converter<bench::error_code, other_error_code> {
+    static constexpr other_error_code convert(const bench::error_code& error) noexcept {
+        return error == bench::error_code::none
+                   ? other_error_code::none
+                   : other_error_code::failed;
+    }
+};
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> failure_same(bench::error_code code) {
+    return rescpp::fail(std::move(code));
+}
+
+[[gnu::noinline]]
+rescpp::result<int, other_error_code> failure_converted(bench::error_code code) {
+    return rescpp::fail(std::move(code));
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> failure_message(const char* message) {
+    return rescpp::fail<bench::message_error>(message);
+}
+
+[[gnu::noinline]]
+bench::error_code failure_error_code(bench::error_code code) {
+    return code;
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+[[gnu::noinline]]
+std::expected<int, bench::error_code> failure_expected(bench::error_code code) {
+    return std::unexpected(code);
+}
+
+[[gnu::noinline]]
+std::expected<int, bench::message_error> failure_expected_message(const char* message) {
+    return std::unexpected(bench::message_error{ message });
+}
+#endif
+
+void failure_result(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = failure_same(bench::opaque(bench::error_code::failed));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void failure_result_converted(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = failure_converted(bench::opaque(bench::error_code::failed));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void failure_result_message(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = failure_message(bench::opaque(bench::long_message));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void failure_raw_error_code(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto code = failure_error_code(bench::opaque(bench::error_code::failed));
+        benchmark::DoNotOptimize(code);
+    }
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+void failure_std_expected(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = failure_expected(bench::opaque(bench::error_code::failed));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void failure_std_expected_message(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = failure_expected_message(bench::opaque(bench::long_message));
+        benchmark::DoNotOptimize(res);
+    }
+}
+#endif
+}
+
+BENCHMARK(failure_result);
+BENCHMARK(failure_result_converted);
+BENCHMARK(failure_result_message);
+BENCHMARK(failure_raw_error_code);
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+BENCHMARK(failure_std_expected);
+BENCHMARK(failure_std_expected_message);
+#endif
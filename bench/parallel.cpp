@@ -0,0 +1,68 @@
+#include "common.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include <res-cpp/parallel.hpp>
+
+// 'state.range(0)' elements with some work each, fails at element 'state.range(1)' (-1 never),
+// sequential loop with the try macro against 'parallel_transform'.
+// Without an error the parallel version scales with the workers, with an early error
+// it stops the chunks behind it instead of finishing them.
+
+namespace {
+rescpp::result<double, bench::message_error> work(int value, int fail_at) {
+    if (value == fail_at) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    double x = value;
+    for (int i = 0; i < 256; ++i) {
+        x = std::sqrt(x + i);
+    }
+    return x;
+}
+
+std::vector<int> make_input(std::size_t size) {
+    std::vector<int> input(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        input[i] = static_cast<int>(i);
+    }
+    return input;
+}
+
+rescpp::result<std::vector<double>, bench::message_error> sequential(const std::vector<int>& input, int fail_at) {
+    std::vector<double> values;
+    values.reserve(input.size());
+    for (const int value : input) {
+        values.push_back(RESCPP_TRY(work(value, fail_at)));
+    }
+    return values;
+}
+
+void transform_sequential(benchmark::State& state) {
+    const auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    const auto fail_at = static_cast<int>(state.range(1));
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sequential(input, fail_at));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void transform_parallel(benchmark::State& state) {
+    const auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    const auto fail_at = static_cast<int>(state.range(1));
+    auto& pool = rescpp::thread_pool::shared();
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::parallel_transform(pool, input, [fail_at](int value) {
+            return work(value, fail_at);
+        }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["workers"] = static_cast<double>(pool.size());
+}
+}
+
+BENCHMARK(transform_sequential)->Args({ 65536, -1 })->Args({ 65536, 6553 })->UseRealTime();
+BENCHMARK(transform_parallel)->Args({ 65536, -1 })->Args({ 65536, 6553 })->UseRealTime();
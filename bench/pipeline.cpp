@@ -0,0 +1,120 @@
+#include "common.hpp"
+
+#include <cstddef>
+
+#include <res-cpp/pipeline.hpp>
+
+// five step chain, written as fused pipeline, as member combinators and by hand,
+// 'state.range(0)' selects the step which fails (0 for none)
+// Every variant lives in its own section and reports its size as 'code_bytes' (ELF only),
+// equal sizes and 'instructions' show the combinators compile to the hand written branches.
+// A variant which returns something else than the hand written chain is skipped with an error.
+
+namespace {
+struct step_error {
+    int step;
+};
+
+template <int Step>
+rescpp::result<int, step_error> checked_step(int value, int fail_at) {
+    if (fail_at == Step) {
+        return rescpp::fail(step_error{ Step });
+    }
+    return value + Step;
+}
+
+[[gnu::noinline, gnu::section("rescpp_bench_fused")]]
+rescpp::result<int, step_error> run_fused(rescpp::result<int, step_error> input, int fail_at) {
+    const rescpp::pipeline steps(
+        rescpp::and_then([fail_at](int value) { return checked_step<1>(value, fail_at); }),
+        rescpp::transform([](int value) { return value * 3; }),
+        rescpp::and_then([fail_at](int value) { return checked_step<2>(value, fail_at); }),
+        rescpp::transform([](int value) { return value - 7; }),
+        rescpp::and_then([fail_at](int value) { return checked_step<3>(value, fail_at); })
+    );
+    return steps(input);
+}
+
+[[gnu::noinline, gnu::section("rescpp_bench_members")]]
+rescpp::result<int, step_error> run_members(rescpp::result<int, step_error> input, int fail_at) {
+    return input
+           .and_then([fail_at](int value) { return checked_step<1>(value, fail_at); })
+           .transform([](int value) { return value * 3; })
+           .and_then([fail_at](int value) { return checked_step<2>(value, fail_at); })
+           .transform([](int value) { return value - 7; })
+           .and_then([fail_at](int value) { return checked_step<3>(value, fail_at); });
+}
+
+[[gnu::noinline, gnu::section("rescpp_bench_manual")]]
+rescpp::result<int, step_error> run_manual(rescpp::result<int, step_error> input, int fail_at) {
+    if (input.has_error()) {
+        return rescpp::fail(input.error());
+    }
+    auto first = checked_step<1>(input.value(), fail_at);
+    if (first.has_error()) {
+        return rescpp::fail(first.error());
+    }
+    auto second = checked_step<2>(first.value() * 3, fail_at);
+    if (second.has_error()) {
+        return rescpp::fail(second.error());
+    }
+    return checked_step<3>(second.value() - 7, fail_at);
+}
+}
+
+#if defined(__ELF__)
+// start and end of the sections, provided by the linker
+extern "C" const char __start_rescpp_bench_fused[], __stop_rescpp_bench_fused[];
+extern "C" const char __start_rescpp_bench_members[], __stop_rescpp_bench_members[];
+extern "C" const char __start_rescpp_bench_manual[], __stop_rescpp_bench_manual[];
+#define RESCPP_BENCH_CODE_BYTES(name) (__stop_rescpp_bench_##name - __start_rescpp_bench_##name)
+#else
+#define RESCPP_BENCH_CODE_BYTES(name) 0
+#endif
+
+namespace {
+bool same_result(const rescpp::result<int, step_error>& lhs, const rescpp::result<int, step_error>& rhs) {
+    if (lhs.has_error() != rhs.has_error()) {
+        return false;
+    }
+    return lhs.has_error() ? lhs.error().step == rhs.error().step : lhs.value() == rhs.value();
+}
+
+template <auto Run>
+void run_chain(benchmark::State& state, std::ptrdiff_t code_bytes) {
+    const int fail_at = static_cast<int>(state.range(0));
+    if (!same_result(Run(1, fail_at), run_manual(1, fail_at))
+        || !same_result(Run(rescpp::fail(step_error{ 0 }), fail_at), run_manual(rescpp::fail(step_error{ 0 }), fail_at))) {
+        state.SkipWithError("result differs from the hand written chain");
+        return;
+    }
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = Run(rescpp::result<int, step_error>(bench::opaque(1)), bench::opaque(fail_at));
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["code_bytes"] = static_cast<double>(code_bytes);
+}
+
+void pipeline_fused(benchmark::State& state) {
+    run_chain<run_fused>(state, RESCPP_BENCH_CODE_BYTES(fused));
+}
+
+void pipeline_members(benchmark::State& state) {
+    run_chain<run_members>(state, RESCPP_BENCH_CODE_BYTES(members));
+}
+
+void pipeline_manual(benchmark::State& state) {
+    run_chain<run_manual>(state, RESCPP_BENCH_CODE_BYTES(manual));
+}
+
+void fail_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("fail_at");
+    bench->DenseRange(0, 3);
+}
+}
+
+BENCHMARK(pipeline_fused)->Apply(fail_args);
+BENCHMARK(pipeline_members)->Apply(fail_args);
+BENCHMARK(pipeline_manual)->Apply(fail_args);
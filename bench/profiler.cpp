@@ -0,0 +1,48 @@
+#include "common.hpp"
+
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/profiler.hpp>
+
+// Cost of the sampling error profiler ('RESCPP_ENABLE_PROFILER') per created error.
+// 'state.range(0)' is the sample interval, one out of that many errors gets its stack captured.
+// In 'res-cpp_bench' (profiler disabled) the interval does nothing, it's the baseline.
+// 'res-cpp_bench_profiler' shows the countdown on unsampled errors and the capture on sampled ones.
+
+namespace {
+struct profiled_error {
+    int value;
+};
+
+// read every iteration, keeps the errors from being folded
+volatile int input = -1;
+
+[[gnu::noinline]]
+rescpp::result<int, profiled_error> profiled_leaf(int value) {
+    if (value < 0) {
+        return rescpp::fail(profiled_error{ value });
+    }
+    return value;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, profiled_error> profiled_chain(int value) {
+    auto leaf = RESCPP_TRY(profiled_leaf(value));
+    return leaf + 1;
+}
+
+void profiler_fail(benchmark::State& state) {
+    rescpp::profiler::set_sample_interval(static_cast<std::uint32_t>(state.range(0)));
+    rescpp::profiler::clear();
+    rescpp::profiler::start();
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(profiled_chain(input));
+    }
+    rescpp::profiler::stop();
+    state.counters["samples"] = static_cast<double>(rescpp::profiler::samples());
+    state.counters["dropped"] = static_cast<double>(rescpp::profiler::dropped());
+    state.counters["profiler_enabled"] = rescpp::profiler::enabled ? 1 : 0;
+}
+}
+
+BENCHMARK(profiler_fail)->ArgName("interval")->Arg(1)->Arg(64)->Arg(1024)->Arg(65536);
@@ -0,0 +1,99 @@
+#include "common.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <res-cpp/result_vector.hpp>
+
+// sum over the values of 'state.range(0)' results with 1% errors,
+// array of results against 'result_vector' (value iteration and a masked scan of the value slots)
+
+namespace {
+using batch_result = rescpp::result<double, bench::message_error>;
+
+bool is_error(std::size_t index) {
+    return index % 100 == 42;
+}
+
+std::vector<batch_result> make_array(std::size_t size) {
+    std::vector<batch_result> batch;
+    batch.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (is_error(i)) {
+            batch.push_back(rescpp::fail<bench::message_error>(bench::long_message));
+        }
+        else {
+            batch.push_back(static_cast<double>(i));
+        }
+    }
+    return batch;
+}
+
+rescpp::result_vector<double, bench::message_error> make_vector(std::size_t size) {
+    rescpp::result_vector<double, bench::message_error> batch;
+    batch.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (is_error(i)) {
+            batch.push_back(rescpp::fail<bench::message_error>(bench::long_message));
+        }
+        else {
+            batch.push_back(static_cast<double>(i));
+        }
+    }
+    return batch;
+}
+
+void sum_array(benchmark::State& state) {
+    const auto batch = make_array(static_cast<std::size_t>(state.range(0)));
+    bench::counters counters(state);
+    for (auto _ : state) {
+        double sum = 0;
+        for (const auto& res : batch) {
+            if (!res.has_error()) {
+                sum += res.value();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] = static_cast<double>(sizeof(batch_result));
+}
+
+void sum_result_vector(benchmark::State& state) {
+    const auto batch = make_vector(static_cast<std::size_t>(state.range(0)));
+    bench::counters counters(state);
+    for (auto _ : state) {
+        double sum = 0;
+        for (const double value : batch.values()) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void sum_result_vector_masked(benchmark::State& state) {
+    const auto batch = make_vector(static_cast<std::size_t>(state.range(0)));
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const auto slots = batch.value_slots();
+        const auto bits = batch.error_bits();
+        double sum = 0;
+        for (std::size_t word = 0; word < bits.size(); ++word) {
+            const std::size_t first = word * 64;
+            const std::size_t last = first + 64 < slots.size() ? first + 64 : slots.size();
+            for (std::size_t i = first; i < last; ++i) {
+                // branch free, the mask selects the value or zero
+                const bool good = ((bits[word] >> (i - first)) & 1) == 0;
+                sum += good ? slots[i] : 0.0;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+
+BENCHMARK(sum_array)->Arg(1024)->Arg(65536)->Arg(1 << 20);
+BENCHMARK(sum_result_vector)->Arg(1024)->Arg(65536)->Arg(1 << 20);
+BENCHMARK(sum_result_vector_masked)->Arg(1024)->Arg(65536)->Arg(1 << 20);
@@ -0,0 +1,110 @@
+#include "common.hpp"
+
+#include <exception>
+#include <optional>
+
+#include <res-cpp/sender.hpp>
+
+// latency per sender stage: chains of 1, 4 and 16 'then_result' stages started inline
+// against the same chain written with results, and the round trip of a hop onto a run loop
+// and onto a thread pool ('sync_wait'). 'allocations' stays 0 for the inline chains.
+
+namespace {
+struct stage_error {
+    int stage;
+};
+
+rescpp::result<int, stage_error> stage(int value) {
+    if (value < 0) {
+        return rescpp::fail(stage_error{ value });
+    }
+    return value + 1;
+}
+
+// read every iteration, keeps the chains from being folded or hoisted
+volatile int input = 0;
+
+struct int_receiver {
+    std::optional<int>* value_;
+
+    void set_value(int value) && {
+        value_->emplace(value);
+    }
+
+    void set_error(stage_error) && {
+        value_->reset();
+    }
+
+    void set_error(std::exception_ptr) && {
+        value_->reset();
+    }
+};
+
+template <int Stages, typename S>
+auto add_stages(S&& sender) {
+    if constexpr (Stages == 0) {
+        return std::forward<S>(sender);
+    }
+    else {
+        return add_stages<Stages - 1>(std::forward<S>(sender) | rescpp::then_result([](int value) { return stage(value); }));
+    }
+}
+
+template <int Stages>
+void sender_stages(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        std::optional<int> value;
+        auto operation = rescpp::connect(add_stages<Stages>(rescpp::as_sender(stage(input))), int_receiver{ &value });
+        operation.start();
+        benchmark::DoNotOptimize(value);
+    }
+    state.counters["stages"] = Stages;
+}
+
+template <int Stages>
+void result_stages(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = stage(input);
+        for (int i = 0; i < Stages && !res.has_error(); ++i) {
+            res = stage(res.value());
+        }
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["stages"] = Stages;
+}
+
+void run_loop_hop(benchmark::State& state) {
+    bench::counters counters(state);
+    for (auto _ : state) {
+        rescpp::run_loop loop;
+        std::optional<int> value;
+        auto operation = rescpp::connect(rescpp::schedule(loop.get_scheduler())
+                                             | rescpp::then_result([] { return stage(0); }),
+                                         int_receiver{ &value });
+        operation.start();
+        loop.finish();
+        loop.run();
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void thread_pool_hop(benchmark::State& state) {
+    rescpp::thread_pool pool(1);
+    bench::counters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rescpp::sync_wait(rescpp::schedule(rescpp::pool_scheduler(pool))
+                                                   | rescpp::then_result([] { return stage(0); })));
+    }
+}
+}
+
+BENCHMARK(sender_stages<1>);
+BENCHMARK(sender_stages<4>);
+BENCHMARK(sender_stages<16>);
+BENCHMARK(result_stages<1>);
+BENCHMARK(result_stages<4>);
+BENCHMARK(result_stages<16>);
+BENCHMARK(run_loop_hop);
+BENCHMARK(thread_pool_hop)->UseRealTime();
@@ -0,0 +1,97 @@
+#include "common.hpp"
+
+#include <cstddef>
+
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/stats.hpp>
+
+// Cost of the error counters ('RESCPP_ENABLE_STATS').
+// 'counted' uses 'fail' and 'RESCPP_TRY', 'plain' the same chain without any hook
+// (what 'fail' and the try macro expand to without 'RESCPP_ENABLE_STATS').
+// In 'res-cpp_bench' both report the same 'code_bytes' (ELF only, own section each),
+// the disabled counters generate the same code. 'res-cpp_bench_stats' shows the cost with counters.
+// 'state.range(0)' is the share of failing calls in percent.
+
+namespace {
+struct stats_error {
+    int value;
+};
+
+using chain_result = rescpp::result<int, stats_error>;
+
+[[gnu::noinline, gnu::section("rescpp_bench_counted")]]
+chain_result counted_leaf(int value) {
+    if (value < 0) {
+        return rescpp::fail(stats_error{ value });
+    }
+    return value + 1;
+}
+
+[[gnu::noinline, gnu::section("rescpp_bench_counted")]]
+chain_result counted_chain(int value) {
+    auto first = RESCPP_TRY(counted_leaf(value));
+    auto second = RESCPP_TRY(counted_leaf(first * 3));
+    return second + 7;
+}
+
+[[gnu::noinline, gnu::section("rescpp_bench_plain")]]
+chain_result plain_leaf(int value) {
+    if (value < 0) {
+        return rescpp::fail(rescpp::detail::pass_error, stats_error{ value });
+    }
+    return value + 1;
+}
+
+// 'RESCPP_TRY' without the hooks
+#define RESCPP_BENCH_PLAIN_TRY(...) \
+    RESCPP_TRY_IMPL((__VA_ARGS__), \
+        return rescpp::fail(rescpp::detail::pass_error, std::move(result_).error()); \
+    )
+
+[[gnu::noinline, gnu::section("rescpp_bench_plain")]]
+chain_result plain_chain(int value) {
+    auto first = RESCPP_BENCH_PLAIN_TRY(plain_leaf(value));
+    auto second = RESCPP_BENCH_PLAIN_TRY(plain_leaf(first * 3));
+    return second + 7;
+}
+}
+
+#if defined(__ELF__)
+// start and end of the sections, provided by the linker
+extern "C" const char __start_rescpp_bench_counted[], __stop_rescpp_bench_counted[];
+extern "C" const char __start_rescpp_bench_plain[], __stop_rescpp_bench_plain[];
+#define RESCPP_BENCH_CODE_BYTES(name) (__stop_rescpp_bench_##name - __start_rescpp_bench_##name)
+#else
+#define RESCPP_BENCH_CODE_BYTES(name) 0
+#endif
+
+namespace {
+void run_chain(benchmark::State& state, chain_result (*chain)(int), std::ptrdiff_t code_bytes) {
+    const int fail_percent = static_cast<int>(state.range(0));
+    std::size_t call = 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        const int input = static_cast<int>(call % 100) < fail_percent ? -1 : static_cast<int>(call % 1000);
+        benchmark::DoNotOptimize(chain(input));
+        ++call;
+    }
+    state.counters["code_bytes"] = static_cast<double>(code_bytes);
+    state.counters["stats_enabled"] = rescpp::stats::enabled ? 1 : 0;
+}
+
+void stats_counted(benchmark::State& state) {
+    run_chain(state, counted_chain, RESCPP_BENCH_CODE_BYTES(counted));
+}
+
+void stats_plain(benchmark::State& state) {
+    run_chain(state, plain_chain, RESCPP_BENCH_CODE_BYTES(plain));
+}
+
+void fail_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("fail_percent");
+    bench->Arg(0)->Arg(1)->Arg(50);
+}
+}
+
+BENCHMARK(stats_counted)->Apply(fail_args);
+BENCHMARK(stats_plain)->Apply(fail_args);
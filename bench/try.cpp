@@ -0,0 +1,179 @@
+#include "common.hpp"
+
+#include <res-cpp/res-cpp.hpp>
+
+// propagation of a value or error through 'state.range(0)' frames,
+// 'state.range(1)' selects the error path
+
+namespace {
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> leaf_result(bool fail) {
+    if (fail) {
+        return rescpp::fail(bench::error_code::failed);
+    }
+    return 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> chain_try(int depth, bool fail) {
+    if (depth == 0) {
+        return leaf_result(fail);
+    }
+    auto value = RESCPP_TRY(chain_try(depth - 1, fail));
+    return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::error_code> chain_try_named(int depth, bool fail) {
+    if (depth == 0) {
+        return leaf_result(fail);
+    }
+    RESCPP_TRY_(value, chain_try_named(depth - 1, fail));
+    return value + 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> leaf_message_result(bool fail) {
+    if (fail) {
+        return rescpp::fail<bench::message_error>(bench::long_message);
+    }
+    return 1;
+}
+
+[[gnu::noinline]]
+rescpp::result<int, bench::message_error> chain_try_message(int depth, bool fail) {
+    if (depth == 0) {
+        return leaf_message_result(fail);
+    }
+    auto value = RESCPP_TRY(chain_try_message(depth - 1, fail));
+    return value + 1;
+}
+
+[[gnu::noinline]]
+bench::error_code chain_error_code(int depth, bool fail, int& out) {
+    if (depth == 0) {
+        if (fail) {
+            return bench::error_code::failed;
+        }
+        out = 1;
+        return bench::error_code::none;
+    }
+    int value = 0;
+    if (auto code = chain_error_code(depth - 1, fail, value); code != bench::error_code::none) {
+        return code;
+    }
+    out = value + 1;
+    return bench::error_code::none;
+}
+
+[[gnu::noinline]]
+int chain_exception(int depth, bool fail) {
+    if (depth == 0) {
+        if (fail) {
+            throw bench::message_error{ bench::long_message };
+        }
+        return 1;
+    }
+    return chain_exception(depth - 1, fail) + 1;
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+[[gnu::noinline]]
+std::expected<int, bench::error_code> chain_expected(int depth, bool fail) {
+    if (depth == 0) {
+        if (fail) {
+            return std::unexpected(bench::error_code::failed);
+        }
+        return 1;
+    }
+    auto value = chain_expected(depth - 1, fail);
+    if (!value) {
+        return std::unexpected(value.error());
+    }
+    return *value + 1;
+}
+#endif
+
+void try_result(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_try(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void try_result_named(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_try_named(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void try_result_message(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_try_message(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void try_error_code(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int value = 0;
+        auto code = chain_error_code(bench::opaque(depth), bench::opaque(fail), value);
+        benchmark::DoNotOptimize(code);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void try_exception(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        try {
+            auto value = chain_exception(bench::opaque(depth), bench::opaque(fail));
+            benchmark::DoNotOptimize(value);
+        }
+        catch (const bench::message_error& e) {
+            benchmark::DoNotOptimize(e.message.data());
+        }
+    }
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+void try_expected(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    const bool fail = state.range(1) != 0;
+    bench::counters counters(state);
+    for (auto _ : state) {
+        auto res = chain_expected(bench::opaque(depth), bench::opaque(fail));
+        benchmark::DoNotOptimize(res);
+    }
+}
+#endif
+
+void depth_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({ "depth", "fail" });
+    bench->ArgsProduct({ { 1, 2, 4, 8, 16, 32 }, { 0, 1 } });
+}
+}
+
+BENCHMARK(try_result)->Apply(depth_args);
+BENCHMARK(try_result_named)->Apply(depth_args);
+BENCHMARK(try_result_message)->Apply(depth_args);
+BENCHMARK(try_error_code)->Apply(depth_args);
+BENCHMARK(try_exception)->Apply(depth_args);
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+BENCHMARK(try_expected)->Apply(depth_args);
+#endif
@@ -0,0 +1,104 @@
+#include "common.hpp"
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include <res-cpp/res-cpp.hpp>
+
+// '.value()' on a good result, this file is built twice:
+// 'res-cpp_bench' with checks and 'res-cpp_bench_unchecked' with 'RESCPP_DISABLE_CHECKS'
+
+#if defined(RESCPP_DISABLE_CHECKS)
+#define RESCPP_BENCH_CHECKS "unchecked"
+#else
+#define RESCPP_BENCH_CHECKS "checked"
+#endif
+
+namespace {
+constexpr int value_count = 1024;
+
+void value_result(benchmark::State& state) {
+    std::vector<rescpp::result<int, bench::error_code>> results;
+    results.reserve(value_count);
+    for (int i = 0; i < value_count; ++i) {
+        results.emplace_back(i);
+    }
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& res : results) {
+            sum += res.value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * value_count);
+}
+
+void value_error_code(benchmark::State& state) {
+    std::vector<std::pair<bench::error_code, int>> results;
+    results.reserve(value_count);
+    for (int i = 0; i < value_count; ++i) {
+        results.emplace_back(bench::error_code::none, i);
+    }
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& [code, value] : results) {
+            if (code != bench::error_code::none) {
+                std::abort();
+            }
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * value_count);
+}
+
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+void value_expected(benchmark::State& state) {
+    std::vector<std::expected<int, bench::error_code>> results;
+    results.reserve(value_count);
+    for (int i = 0; i < value_count; ++i) {
+        results.emplace_back(i);
+    }
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& res : results) {
+            sum += res.value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * value_count);
+}
+
+void value_expected_unchecked(benchmark::State& state) {
+    std::vector<std::expected<int, bench::error_code>> results;
+    results.reserve(value_count);
+    for (int i = 0; i < value_count; ++i) {
+        results.emplace_back(i);
+    }
+
+    bench::counters counters(state);
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& res : results) {
+            sum += *res;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * value_count);
+}
+#endif
+}
+
+BENCHMARK(value_result)->Name("value_result/" RESCPP_BENCH_CHECKS);
+BENCHMARK(value_error_code)->Name("value_error_code/" RESCPP_BENCH_CHECKS);
+#if defined(RESCPP_BENCH_HAS_EXPECTED)
+BENCHMARK(value_expected)->Name("value_expected/" RESCPP_BENCH_CHECKS);
+BENCHMARK(value_expected_unchecked)->Name("value_expected_unchecked/" RESCPP_BENCH_CHECKS);
+#endif
@@ -0,0 +1,356 @@
+#ifndef RESCPP_ANY_ERROR_H
+#define RESCPP_ANY_ERROR_H
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "res-cpp.hpp"
+#include "code.hpp"
+
+// Type erased error, 'result<T, rescpp::any_error>' takes the error of any result,
+// 'fail(error)' and the try macros convert without a 'type_converter'.
+// Errors up to 'RESCPP_ANY_ERROR_BUFFER' bytes (default 24) which are nothrow move constructible
+// are stored inline, bigger ones on the heap. Stored errors have to be copy constructible.
+// A vtable per error type gives the category, the message and equality.
+//
+//   rescpp::result<config, rescpp::any_error> load() {
+//       auto text = RESCPP_TRY(read_file("config")); // result<std::string, io_error>
+//       return RESCPP_TRY(parse(text));               // result<config, parse_error>
+//   }
+//
+//   if (res.error().is<io_error>()) {
+//       io_error error = res.error().as<io_error>();
+//   }
+
+#ifndef RESCPP_ANY_ERROR_BUFFER
+#define RESCPP_ANY_ERROR_BUFFER 24
+#endif
+
+namespace rescpp {
+/// Optional description of an error stored in an 'any_error'.
+/// - 'static constexpr std::string_view category'
+/// - 'static std::string_view message(const E&) noexcept', has to stay valid as long as the error
+/// Without it the category is the name of the type (or its 'code_category' name) and the message
+/// comes from the 'code_category', a 'message()' member function or a 'message' member, empty otherwise.
+template <typename E>
+struct any_error_traits {};
+
+class any_error;
+
+namespace detail {
+struct any_error_vtable {
+    std::string_view category;
+    std::string_view (*message)(const any_error& error) noexcept;
+    bool (*equal)(const any_error& error, const any_error& other) noexcept;
+    void (*copy)(any_error& to, const any_error& from);
+    void (*move)(any_error& to, any_error& from) noexcept;
+    void (*destroy)(any_error& error) noexcept;
+};
+
+/// text which outlives the expression it came from, a view of a member or a literal
+template <typename T>
+concept any_error_stable_text = std::convertible_to<T, std::string_view>
+    && (std::is_lvalue_reference_v<T>
+        || std::is_same_v<std::remove_cv_t<T>, std::string_view>
+        || std::is_same_v<std::decay_t<T>, const char*>);
+
+template <typename E>
+concept any_error_traits_category = requires {
+    { any_error_traits<E>::category } -> std::convertible_to<std::string_view>;
+};
+
+template <typename E>
+concept any_error_traits_message = requires(const E& error) {
+    { any_error_traits<E>::message(error) } noexcept -> std::convertible_to<std::string_view>;
+};
+
+template <typename E>
+concept any_error_message_function = requires(const E& error) {
+    { error.message() } -> any_error_stable_text;
+};
+
+template <typename E>
+concept any_error_message_member = requires(const E& error) {
+    { error.message } -> any_error_stable_text;
+};
+
+template <typename>
+struct is_in_place_type : std::false_type {};
+
+template <typename E>
+struct is_in_place_type<std::in_place_type_t<E>> : std::true_type {};
+
+template <typename E>
+inline constexpr std::string_view any_error_category() noexcept {
+    if constexpr (any_error_traits_category<E>) {
+        return any_error_traits<E>::category;
+    }
+    else if constexpr (code_enum<E>) {
+        return code_category<E>::name;
+    }
+    else {
+        return type_name<E>();
+    }
+}
+
+template <typename E>
+inline std::string_view any_error_message(const E& error) noexcept {
+    if constexpr (any_error_traits_message<E>) {
+        return any_error_traits<E>::message(error);
+    }
+    else if constexpr (code_enum<E>) {
+        return code_category<E>::message(error);
+    }
+    else if constexpr (any_error_message_function<E>) {
+        return error.message();
+    }
+    else if constexpr (any_error_message_member<E>) {
+        return error.message;
+    }
+    else {
+        return {};
+    }
+}
+}
+
+class any_error {
+public:
+    static inline constexpr std::size_t buffer_size = RESCPP_ANY_ERROR_BUFFER;
+
+    /// 'E' is stored in the buffer, otherwise on the heap
+    template <typename E>
+    static inline constexpr bool stored_inline = sizeof(E) <= buffer_size
+        && alignof(E) <= alignof(void*)
+        && std::is_nothrow_move_constructible_v<E>;
+
+private:
+    // 'nullptr' only after a heap stored error was moved out
+    const detail::any_error_vtable* vtable_;
+
+    union {
+        alignas(void*) unsigned char buffer_[buffer_size];
+        void* heap_;
+    };
+
+    template <typename E>
+    [[nodiscard]]
+    inline E* pointer() noexcept {
+        if constexpr (stored_inline<E>) {
+            return std::launder(reinterpret_cast<E*>(buffer_));
+        }
+        else {
+            return static_cast<E*>(heap_);
+        }
+    }
+
+    template <typename E>
+    [[nodiscard]]
+    inline const E* pointer() const noexcept {
+        if constexpr (stored_inline<E>) {
+            return std::launder(reinterpret_cast<const E*>(buffer_));
+        }
+        else {
+            return static_cast<const E*>(heap_);
+        }
+    }
+
+    template <typename E, typename... Args>
+    inline void construct(Args&&... args) {
+        if constexpr (stored_inline<E>) {
+            std::construct_at(reinterpret_cast<E*>(buffer_), std::forward<Args>(args)...);
+        }
+        else {
+            heap_ = new E(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename E>
+    static inline std::string_view message_of(const any_error& error) noexcept {
+        return detail::any_error_message(*error.pointer<E>());
+    }
+
+    template <typename E>
+    static inline bool equal(const any_error& error, const any_error& other) noexcept {
+        if constexpr (std::equality_comparable<E>) {
+            return *error.pointer<E>() == *other.pointer<E>();
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <typename E>
+    static inline void copy(any_error& to, const any_error& from) {
+        to.construct<E>(*from.pointer<E>());
+    }
+
+    template <typename E>
+    static inline void move(any_error& to, any_error& from) noexcept {
+        if constexpr (stored_inline<E>) {
+            std::construct_at(reinterpret_cast<E*>(to.buffer_), std::move(*from.pointer<E>()));
+        }
+        else {
+            // the heap object changes owner, 'from' is left empty
+            to.heap_ = from.heap_;
+            from.vtable_ = nullptr;
+        }
+    }
+
+    template <typename E>
+    static inline void destroy(any_error& error) noexcept {
+        if constexpr (stored_inline<E>) {
+            std::destroy_at(error.pointer<E>());
+        }
+        else {
+            delete error.pointer<E>();
+        }
+    }
+
+    template <typename E>
+    static inline constexpr detail::any_error_vtable vtable_for{
+        detail::any_error_category<E>(),
+        &message_of<E>,
+        &equal<E>,
+        &copy<E>,
+        &move<E>,
+        &destroy<E>,
+    };
+
+    inline void reset() noexcept {
+        if (vtable_ != nullptr) {
+            vtable_->destroy(*this);
+            vtable_ = nullptr;
+        }
+    }
+
+public:
+    /// explicit, errors still convert where a result changes its error type ('fail', try macros, 'co_await')
+    template <typename E>
+        requires (!std::is_same_v<std::remove_cvref_t<E>, any_error>
+            && !detail::is_in_place_type<std::remove_cvref_t<E>>::value
+            && !std::is_pointer_v<std::remove_cvref_t<E>>
+            && std::is_copy_constructible_v<std::remove_cvref_t<E>>
+            && std::is_constructible_v<std::remove_cvref_t<E>, E>)
+    explicit inline any_error(E&& error)
+        : vtable_(nullptr) {
+        using error_type = std::remove_cvref_t<E>;
+        construct<error_type>(std::forward<E>(error));
+        vtable_ = &vtable_for<error_type>;
+    }
+
+    template <typename E, typename... Args>
+        requires (!std::is_same_v<E, any_error>
+            && std::is_copy_constructible_v<E>
+            && std::is_constructible_v<E, Args...>)
+    explicit inline any_error(std::in_place_type_t<E>, Args&&... args)
+        : vtable_(nullptr) {
+        construct<E>(std::forward<Args>(args)...);
+        vtable_ = &vtable_for<E>;
+    }
+
+    inline any_error(const any_error& other)
+        : vtable_(nullptr) {
+        if (other.vtable_ != nullptr) {
+            other.vtable_->copy(*this, other);
+            vtable_ = other.vtable_;
+        }
+    }
+
+    inline any_error(any_error&& other) noexcept
+        : vtable_(other.vtable_) {
+        if (vtable_ != nullptr) {
+            vtable_->move(*this, other);
+        }
+    }
+
+    /// strong guarantee, the copy is made before the current error gets destroyed
+    inline any_error& operator=(const any_error& other) {
+        if (this != &other) {
+            any_error copied(other);
+            *this = std::move(copied);
+        }
+        return *this;
+    }
+
+    inline any_error& operator=(any_error&& other) noexcept {
+        if (this != &other) {
+            reset();
+            // moving a heap stored error clears 'other.vtable_'
+            const detail::any_error_vtable* vtable = other.vtable_;
+            if (vtable != nullptr) {
+                vtable->move(*this, other);
+                vtable_ = vtable;
+            }
+        }
+        return *this;
+    }
+
+    inline ~any_error() noexcept {
+        reset();
+    }
+
+    /// only an 'any_error' a heap stored error was moved out of is empty
+    [[nodiscard]]
+    inline bool empty() const noexcept {
+        return vtable_ == nullptr;
+    }
+
+    /// One pointer compare against the vtable of 'E'.
+    /// Shared libraries built with hidden visibility get their own vtable per type,
+    /// an error created in one of them is not 'is<E>()' in another one.
+    template <typename E>
+    [[nodiscard]]
+    inline bool is() const noexcept {
+        return vtable_ == &vtable_for<E>;
+    }
+
+    /// only valid if 'is<E>()'
+    template <typename E>
+    [[nodiscard]]
+    inline E& as() & noexcept {
+        return *pointer<E>();
+    }
+
+    /// only valid if 'is<E>()'
+    template <typename E>
+    [[nodiscard]]
+    inline const E& as() const & noexcept {
+        return *pointer<E>();
+    }
+
+    /// only valid if 'is<E>()'
+    template <typename E>
+    [[nodiscard]]
+    inline E&& as() && noexcept {
+        return std::move(*pointer<E>());
+    }
+
+    /// see 'any_error_traits', empty if 'empty()'
+    [[nodiscard]]
+    inline std::string_view category() const noexcept {
+        return vtable_ != nullptr ? vtable_->category : std::string_view();
+    }
+
+    /// see 'any_error_traits', empty if 'empty()'
+    [[nodiscard]]
+    inline std::string_view message() const noexcept {
+        return vtable_ != nullptr ? vtable_->message(*this) : std::string_view();
+    }
+
+    /// same type and equal, errors without 'operator==' are never equal
+    [[nodiscard]]
+    inline bool operator==(const any_error& other) const noexcept {
+        if (vtable_ != other.vtable_) {
+            return false;
+        }
+        return vtable_ == nullptr || vtable_->equal(*this, other);
+    }
+};
+}
+
+#endif //RESCPP_ANY_ERROR_H
@@ -0,0 +1,49 @@
+#ifndef RESCPP_ARENA_H
+#define RESCPP_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "res-cpp.hpp"
+
+// Monotonic arena for the errors of one request.
+// Errors using 'std::pmr' allocators get their memory from an inline buffer
+// (and the upstream resource once it is used up), everything is freed at once by 'release()'
+// or when the arena is destroyed. Errors allocated from the arena must not outlive either.
+//
+//   rescpp::request_arena<> arena;
+//   rescpp::result<int, error> res = rescpp::fail<error>(std::allocator_arg, arena.allocator(), "message");
+//   ...
+//   arena.release();
+
+namespace rescpp {
+template <std::size_t Size = 4096>
+class request_arena {
+    alignas(std::max_align_t) std::byte buffer_[Size];
+    std::pmr::monotonic_buffer_resource resource_;
+
+public:
+    explicit inline request_arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : resource_(buffer_, Size, upstream) {}
+
+    request_arena(const request_arena&) = delete;
+    request_arena& operator=(const request_arena&) = delete;
+
+    [[nodiscard]]
+    inline std::pmr::memory_resource* resource() noexcept {
+        return &resource_;
+    }
+
+    [[nodiscard]]
+    inline std::pmr::polymorphic_allocator<> allocator() noexcept {
+        return std::pmr::polymorphic_allocator<>(&resource_);
+    }
+
+    /// frees everything allocated, following allocations start again at the inline buffer
+    inline void release() noexcept {
+        resource_.release();
+    }
+};
+}
+
+#endif //RESCPP_ARENA_H
@@ -0,0 +1,413 @@
+#ifndef RESCPP_BATCH_H
+#define RESCPP_BATCH_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define RESCPP_BATCH_X86
+#include <immintrin.h>
+#endif
+
+#include "res-cpp.hpp"
+
+// Status queries over many results at once:
+// 'all_ok', 'any_error', 'count_errors', 'first_error_index' and 'compact_values'.
+//
+// Work on contiguous ranges of results and on packed error bitmaps (e.g. 'result_vector::error_bits()').
+// Results with a tagged storage get their 'has_error_' flags read with SSE2 or AVX2,
+// selected at runtime, other results and other architectures use a scalar loop.
+//
+//   if (!rescpp::all_ok(parsed)) {
+//       const auto index = rescpp::first_error_index(parsed);
+//       ...
+//   }
+
+namespace rescpp {
+enum class batch_isa {
+    scalar,
+    sse2,
+    avx2,
+};
+
+/// returned by 'first_error_index' when there is no error
+inline constexpr std::size_t no_error_index = static_cast<std::size_t>(-1);
+
+/// best instruction set of this machine, detected once
+[[nodiscard]]
+inline batch_isa detected_batch_isa() noexcept {
+#if defined(RESCPP_BATCH_X86)
+    static const batch_isa isa = __builtin_cpu_supports("avx2") ? batch_isa::avx2 : batch_isa::sse2;
+    return isa;
+#else
+    return batch_isa::scalar;
+#endif
+}
+
+namespace detail {
+/// requested instruction set, limited to what this machine supports
+[[nodiscard]]
+inline batch_isa usable_batch_isa(batch_isa requested) noexcept {
+    return std::min(requested, detected_batch_isa());
+}
+
+template <typename R>
+concept result_contiguous_range = std::ranges::contiguous_range<R>
+    && is_result_v<std::remove_cv_t<std::ranges::range_value_t<R>>>;
+
+// The flag visitors call 'f(first, errors, flags, bits_per_element)' with chunks of elements.
+// Bit 'b' of 'flags' stands for element 'first + b / bits_per_element',
+// the same bit in 'errors' is set if that element is an error.
+// Visiting stops once 'f' returns true.
+
+/// mask with the lowest 'count' bits set
+[[nodiscard]]
+inline constexpr std::uint64_t low_bits(std::size_t count) noexcept {
+    return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+}
+
+template <typename F>
+inline bool visit_flags_scalar(const std::byte* data, std::size_t first, std::size_t count,
+                               std::size_t stride, std::size_t offset, F& f) {
+    for (; first < count; first += 64) {
+        const std::size_t chunk = count - first < 64 ? count - first : 64;
+        std::uint64_t errors = 0;
+        for (std::size_t i = 0; i < chunk; ++i) {
+            errors |= static_cast<std::uint64_t>(data[(first + i) * stride + offset] != std::byte{ 0 }) << i;
+        }
+        if (f(first, errors, low_bits(chunk), std::size_t(1))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// bytes of the flags in a 64 byte group of elements
+[[nodiscard]]
+inline constexpr std::uint64_t flag_pattern(std::size_t stride, std::size_t offset) noexcept {
+    std::uint64_t pattern = 0;
+    for (std::size_t byte = offset; byte < 64; byte += stride) {
+        pattern |= std::uint64_t(1) << byte;
+    }
+    return pattern;
+}
+
+#if defined(RESCPP_BATCH_X86)
+// Strides dividing 16: every 16 byte block holds whole elements, the non zero bytes
+// of a 64 byte group masked with the flag positions are the errors.
+template <typename F>
+inline bool visit_flags_sse2(const std::byte* data, std::size_t count,
+                             std::size_t stride, std::size_t offset, F& f) {
+    std::size_t first = 0;
+    if (16 % stride == 0) {
+        const std::uint64_t pattern = flag_pattern(stride, offset);
+        const std::size_t per_group = 64 / stride;
+        const __m128i zero = _mm_setzero_si128();
+        for (; first + per_group <= count; first += per_group) {
+            const auto* group = reinterpret_cast<const __m128i*>(data + first * stride);
+            std::uint64_t zeros = 0;
+            for (int block = 0; block < 4; ++block) {
+                const __m128i bytes = _mm_loadu_si128(group + block);
+                zeros |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)))) << (block * 16);
+            }
+            if (f(first, ~zeros & pattern, pattern, stride)) {
+                return true;
+            }
+        }
+    }
+    return visit_flags_scalar(data, first, count, stride, offset, f);
+}
+
+// Strides dividing 32 like SSE2 with 32 byte blocks, other strides gather the flags of 8 elements.
+template <typename F>
+[[gnu::target("avx2")]]
+inline bool visit_flags_avx2(const std::byte* data, std::size_t count,
+                             std::size_t stride, std::size_t offset, F& f) {
+    std::size_t first = 0;
+    if (32 % stride == 0) {
+        const std::uint64_t pattern = flag_pattern(stride, offset);
+        const std::size_t per_group = 64 / stride;
+        const __m256i zero = _mm256_setzero_si256();
+        for (; first + per_group <= count; first += per_group) {
+            const auto* group = reinterpret_cast<const __m256i*>(data + first * stride);
+            const __m256i low = _mm256_loadu_si256(group);
+            const __m256i high = _mm256_loadu_si256(group + 1);
+            const auto low_zeros = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, zero)));
+            const auto high_zeros = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, zero)));
+            const std::uint64_t zeros = low_zeros | static_cast<std::uint64_t>(high_zeros) << 32;
+            if (f(first, ~zeros & pattern, pattern, stride)) {
+                return true;
+            }
+        }
+    }
+    else {
+        const auto step = static_cast<int>(stride);
+        const __m256i index = _mm256_add_epi32(
+            _mm256_setr_epi32(0, step, 2 * step, 3 * step, 4 * step, 5 * step, 6 * step, 7 * step),
+            _mm256_set1_epi32(static_cast<int>(offset)));
+        const __m256i low_byte = _mm256_set1_epi32(0xFF);
+        const __m256i zero = _mm256_setzero_si256();
+        // gathers read 4 bytes per flag, the last element is left to the scalar loop
+        for (; first + 8 < count; first += 8) {
+            const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data + first * stride), index, 1);
+            const __m256i is_zero = _mm256_cmpeq_epi32(_mm256_and_si256(words, low_byte), zero);
+            const auto zeros = static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(is_zero)));
+            if (f(first, ~zeros & 0xFF, std::uint64_t(0xFF), std::size_t(1))) {
+                return true;
+            }
+        }
+    }
+    return visit_flags_scalar(data, first, count, stride, offset, f);
+}
+#endif
+
+template <typename R, typename F>
+inline void visit_error_flags(const R* results, std::size_t count, batch_isa isa, F&& f) {
+    using layout = result_layout<R>;
+
+    if constexpr (layout::has_error_flag) {
+        const auto* data = reinterpret_cast<const std::byte*>(results);
+        switch (usable_batch_isa(isa)) {
+#if defined(RESCPP_BATCH_X86)
+        case batch_isa::avx2:
+            visit_flags_avx2(data, count, sizeof(R), layout::error_flag_offset, f);
+            return;
+        case batch_isa::sse2:
+            visit_flags_sse2(data, count, sizeof(R), layout::error_flag_offset, f);
+            return;
+#endif
+        default:
+            visit_flags_scalar(data, 0, count, sizeof(R), layout::error_flag_offset, f);
+            return;
+        }
+    }
+    else {
+        // the state is encoded in the value or error, only 'has_error()' knows it
+        for (std::size_t first = 0; first < count; first += 64) {
+            const std::size_t chunk = count - first < 64 ? count - first : 64;
+            std::uint64_t errors = 0;
+            for (std::size_t i = 0; i < chunk; ++i) {
+                errors |= static_cast<std::uint64_t>(results[first + i].has_error()) << i;
+            }
+            if (f(first, errors, low_bits(chunk), std::size_t(1))) {
+                return;
+            }
+        }
+    }
+}
+
+template <typename R>
+[[nodiscard]]
+inline decltype(auto) known_value(const R& res) noexcept {
+    if constexpr (result_layout<R>::has_error_flag && !std::is_reference_v<typename R::value_type>) {
+        return result_layout<R>::unchecked_value(res);
+    }
+    else {
+        return res.value();
+    }
+}
+
+#if defined(RESCPP_BATCH_X86)
+[[gnu::target("avx2")]]
+inline std::size_t first_nonzero_word_avx2(const std::uint64_t* words, std::size_t count) noexcept {
+    std::size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + index));
+        if (!_mm256_testz_si256(block, block)) {
+            break;
+        }
+    }
+    for (; index < count && words[index] == 0; ++index) {}
+    return index;
+}
+
+inline std::size_t first_nonzero_word_sse2(const std::uint64_t* words, std::size_t count) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + index));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)) != 0xFFFF) {
+            break;
+        }
+    }
+    for (; index < count && words[index] == 0; ++index) {}
+    return index;
+}
+
+[[gnu::target("avx2,popcnt")]]
+inline std::size_t count_bits_avx2(const std::uint64_t* words, std::size_t count) noexcept {
+    std::size_t bits = 0;
+    for (std::size_t index = 0; index < count; ++index) {
+        bits += static_cast<std::size_t>(std::popcount(words[index]));
+    }
+    return bits;
+}
+#endif
+
+/// index of the first word which is not zero, 'count' if there is none
+[[nodiscard]]
+inline std::size_t first_nonzero_word(std::span<const std::uint64_t> words, batch_isa isa) noexcept {
+    switch (usable_batch_isa(isa)) {
+#if defined(RESCPP_BATCH_X86)
+    case batch_isa::avx2:
+        return first_nonzero_word_avx2(words.data(), words.size());
+    case batch_isa::sse2:
+        return first_nonzero_word_sse2(words.data(), words.size());
+#endif
+    default: {
+        std::size_t index = 0;
+        for (; index < words.size() && words[index] == 0; ++index) {}
+        return index;
+    }
+    }
+}
+}
+
+// contiguous ranges of results
+
+template <typename R>
+    requires (detail::result_contiguous_range<R>)
+[[nodiscard]]
+inline bool any_error(const R& results, batch_isa isa = detected_batch_isa()) {
+    bool found = false;
+    detail::visit_error_flags(std::ranges::data(results), std::ranges::size(results), isa,
+                              [&found](std::size_t, std::uint64_t errors, std::uint64_t, std::size_t) {
+                                  found = errors != 0;
+                                  return found;
+                              });
+    return found;
+}
+
+template <typename R>
+    requires (detail::result_contiguous_range<R>)
+[[nodiscard]]
+inline bool all_ok(const R& results, batch_isa isa = detected_batch_isa()) {
+    return !any_error(results, isa);
+}
+
+template <typename R>
+    requires (detail::result_contiguous_range<R>)
+[[nodiscard]]
+inline std::size_t count_errors(const R& results, batch_isa isa = detected_batch_isa()) {
+    std::size_t count = 0;
+    detail::visit_error_flags(std::ranges::data(results), std::ranges::size(results), isa,
+                              [&count](std::size_t, std::uint64_t errors, std::uint64_t, std::size_t) {
+                                  count += static_cast<std::size_t>(std::popcount(errors));
+                                  return false;
+                              });
+    return count;
+}
+
+/// 'no_error_index' if there is no error
+template <typename R>
+    requires (detail::result_contiguous_range<R>)
+[[nodiscard]]
+inline std::size_t first_error_index(const R& results, batch_isa isa = detected_batch_isa()) {
+    std::size_t index = no_error_index;
+    detail::visit_error_flags(std::ranges::data(results), std::ranges::size(results), isa,
+                              [&index](std::size_t first, std::uint64_t errors, std::uint64_t, std::size_t bits_per_element) {
+                                  if (errors == 0) {
+                                      return false;
+                                  }
+                                  index = first + static_cast<std::size_t>(std::countr_zero(errors)) / bits_per_element;
+                                  return true;
+                              });
+    return index;
+}
+
+/// Copies the values of the good results to 'out', returns how many were copied.
+/// 'out' needs room for every result.
+template <typename R, typename Out>
+    requires (detail::result_contiguous_range<R>)
+inline std::size_t compact_values(const R& results, Out* out, batch_isa isa = detected_batch_isa()) {
+    const auto* data = std::ranges::data(results);
+    std::size_t written = 0;
+    detail::visit_error_flags(data, std::ranges::size(results), isa,
+                              [data, out, &written](std::size_t first, std::uint64_t errors, std::uint64_t flags, std::size_t bits_per_element) {
+                                  if (errors == 0) {
+                                      // only good results, copied without walking the bits
+                                      const auto chunk = static_cast<std::size_t>(std::popcount(flags));
+                                      const auto* source = data + first;
+                                      auto* target = out + written;
+                                      for (std::size_t i = 0; i < chunk; ++i) {
+                                          target[i] = detail::known_value(source[i]);
+                                      }
+                                      written += chunk;
+                                      return false;
+                                  }
+                                  for (std::uint64_t good = flags & ~errors; good != 0; good &= good - 1) {
+                                      const auto element = first + static_cast<std::size_t>(std::countr_zero(good)) / bits_per_element;
+                                      out[written++] = detail::known_value(data[element]);
+                                  }
+                                  return false;
+                              });
+    return written;
+}
+
+// packed error bitmaps, bit 'i % 64' of word 'i / 64' set if element 'i' is an error, unused bits zero
+
+[[nodiscard]]
+inline bool any_error(std::span<const std::uint64_t> error_bits, batch_isa isa = detected_batch_isa()) noexcept {
+    return detail::first_nonzero_word(error_bits, isa) != error_bits.size();
+}
+
+[[nodiscard]]
+inline bool all_ok(std::span<const std::uint64_t> error_bits, batch_isa isa = detected_batch_isa()) noexcept {
+    return !any_error(error_bits, isa);
+}
+
+[[nodiscard]]
+inline std::size_t count_errors(std::span<const std::uint64_t> error_bits, batch_isa isa = detected_batch_isa()) noexcept {
+#if defined(RESCPP_BATCH_X86)
+    if (detail::usable_batch_isa(isa) == batch_isa::avx2) {
+        return detail::count_bits_avx2(error_bits.data(), error_bits.size());
+    }
+#endif
+    std::size_t count = 0;
+    for (const std::uint64_t word : error_bits) {
+        count += static_cast<std::size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+/// 'no_error_index' if there is no error
+[[nodiscard]]
+inline std::size_t first_error_index(std::span<const std::uint64_t> error_bits, batch_isa isa = detected_batch_isa()) noexcept {
+    const std::size_t word = detail::first_nonzero_word(error_bits, isa);
+    if (word == error_bits.size()) {
+        return no_error_index;
+    }
+    return word * 64 + static_cast<std::size_t>(std::countr_zero(error_bits[word]));
+}
+
+/// Copies the values of 'value_slots' whose bit is not set to 'out', returns how many were copied.
+/// Words without errors get copied as a whole. 'out' needs room for every slot.
+template <typename T>
+inline std::size_t compact_values(std::span<const T> value_slots, std::span<const std::uint64_t> error_bits, T* out,
+                                  batch_isa isa = detected_batch_isa()) {
+    std::size_t written = 0;
+    for (std::size_t word = 0; word < error_bits.size(); ++word) {
+        const std::size_t first = word * 64;
+        const std::size_t chunk = value_slots.size() - first < 64 ? value_slots.size() - first : 64;
+        if (error_bits[word] == 0 && isa != batch_isa::scalar) {
+            out = std::copy_n(value_slots.data() + first, chunk, out);
+            written += chunk;
+            continue;
+        }
+
+        const std::uint64_t used = chunk == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << chunk) - 1;
+        for (std::uint64_t good = ~error_bits[word] & used; good != 0; good &= good - 1) {
+            *out++ = value_slots[first + static_cast<std::size_t>(std::countr_zero(good))];
+            ++written;
+        }
+    }
+    return written;
+}
+}
+
+#endif //RESCPP_BATCH_H
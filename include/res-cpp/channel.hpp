@@ -0,0 +1,342 @@
+#ifndef RESCPP_CHANNEL_H
+#define RESCPP_CHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "res-cpp.hpp"
+
+// Bounded lock free channel passing results between pipeline stages.
+// Results get constructed in place in the slots of a ring buffer, 'push' takes the arguments
+// of a result constructor ('std::in_place, args...', a value or 'fail<E>(args...)').
+//
+// 'close(error)' ends the channel: pushes fail from then on, consumers get the remaining
+// results and after that 'error' on every pop. Consumers see the close error like any pushed error.
+//
+// 'channel_mode::spsc' allows one producer and one consumer, the producer is the one closing the channel.
+// 'channel_mode::mpmc' (default) allows any number of both and closing from any thread.
+// A claimed mpmc slot has to be published, so its results have to be nothrow move constructible:
+// a result whose constructor may throw gets constructed before claiming a slot and moved in.
+//
+//   rescpp::result_channel<frame, decode_error> frames(256);
+//   // producer
+//   frames.push(std::in_place, width, height);
+//   frames.close(decode_error::end_of_stream);
+//   // consumer
+//   for (auto res = frames.pop(); !res.has_error(); res = frames.pop()) { ... }
+
+namespace rescpp {
+enum class channel_mode {
+    spsc,
+    mpmc,
+};
+
+enum class channel_state {
+    ok,
+    full,
+    closed,
+};
+
+namespace detail {
+/// counters written by different threads live on their own cache line
+inline constexpr std::size_t channel_cache_line = 64;
+
+[[nodiscard]]
+inline constexpr std::size_t channel_capacity(std::size_t requested) noexcept {
+    std::size_t capacity = 2;
+    while (capacity < requested) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/// spins a few times, then gives the time slice away
+class channel_backoff {
+    std::uint32_t step_ = 0;
+
+public:
+    inline void wait() noexcept {
+        if (step_ < 6) {
+            for (std::uint32_t i = 0; i < (std::uint32_t(1) << step_); ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+            ++step_;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <typename R, channel_mode Mode>
+struct channel_slot;
+
+template <typename R>
+struct channel_slot<R, channel_mode::spsc> {
+    alignas(R) std::byte storage[sizeof(R)];
+};
+
+// position the slot is ready for: 'position' to be written, 'position + 1' to be read
+template <typename R>
+struct channel_slot<R, channel_mode::mpmc> {
+    std::atomic<std::size_t> sequence;
+    alignas(R) std::byte storage[sizeof(R)];
+};
+}
+
+template <typename T, typename E, channel_mode Mode = channel_mode::mpmc>
+class result_channel {
+public:
+    using value_type = T;
+    using error_type = E;
+    using result_type = result<T, E>;
+
+    static inline constexpr channel_mode mode = Mode;
+
+    // a throw between claiming and publishing a slot would block every consumer on it
+    static_assert(Mode == channel_mode::spsc || std::is_nothrow_move_constructible_v<result_type>,
+                  "'channel_mode::mpmc' needs a nothrow move constructible 'result<T, E>'");
+
+private:
+    using slot = detail::channel_slot<result_type, Mode>;
+
+    // mpmc: set in 'tail_' once closed, a producer claiming a slot with a compare exchange sees it
+    static inline constexpr std::size_t closed_bit = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+
+    std::size_t mask_;
+    std::unique_ptr<slot[]> slots_;
+
+    std::optional<E> close_error_;
+    std::atomic<bool> closing_ = false;
+
+    alignas(detail::channel_cache_line) std::atomic<std::size_t> head_ = 0;
+    // spsc: last seen 'tail_' of the consumer
+    std::size_t cached_tail_ = 0;
+
+    alignas(detail::channel_cache_line) std::atomic<std::size_t> tail_ = 0;
+    // spsc: last seen 'head_' of the producer
+    std::size_t cached_head_ = 0;
+    std::atomic<bool> closed_ = false;
+
+    [[nodiscard]]
+    inline result_type* slot_result(slot& entry) noexcept {
+        return std::launder(reinterpret_cast<result_type*>(entry.storage));
+    }
+
+    [[nodiscard]]
+    inline result_type take(slot& entry) {
+        result_type* res = slot_result(entry);
+        result_type taken(std::move(*res));
+        res->~result_type();
+        return taken;
+    }
+
+    [[nodiscard]]
+    inline result_type close_result() const {
+        return result_type(detail::error, *close_error_);
+    }
+
+public:
+    /// 'capacity' gets rounded up to a power of two
+    explicit inline result_channel(std::size_t capacity)
+        : mask_(detail::channel_capacity(capacity) - 1),
+          slots_(std::make_unique<slot[]>(mask_ + 1)) {
+        if constexpr (Mode == channel_mode::mpmc) {
+            for (std::size_t i = 0; i <= mask_; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    result_channel(const result_channel&) = delete;
+    result_channel& operator=(const result_channel&) = delete;
+
+    inline ~result_channel() {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed) & ~closed_bit;
+        for (std::size_t pos = head_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+            slot_result(slots_[pos & mask_])->~result_type();
+        }
+    }
+
+    [[nodiscard]]
+    inline std::size_t capacity() const noexcept {
+        return mask_ + 1;
+    }
+
+    /// Constructs a result from 'args' in the next free slot.
+    /// mpmc channels construct results which may throw before claiming a slot and move from 'args' even if full.
+    template <typename... Args>
+    inline channel_state try_push(Args&&... args) {
+        if constexpr (Mode == channel_mode::spsc) {
+            if (closed_.load(std::memory_order_relaxed)) {
+                return channel_state::closed;
+            }
+            const std::size_t pos = tail_.load(std::memory_order_relaxed);
+            if (pos - cached_head_ > mask_) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (pos - cached_head_ > mask_) {
+                    return channel_state::full;
+                }
+            }
+            ::new (static_cast<void*>(slots_[pos & mask_].storage)) result_type(std::forward<Args>(args)...);
+            tail_.store(pos + 1, std::memory_order_release);
+            return channel_state::ok;
+        }
+        else if constexpr (!std::is_nothrow_constructible_v<result_type, Args&&...>) {
+            // a claimed slot has to be published, a constructor which throws is run before claiming one
+            return try_push(result_type(std::forward<Args>(args)...));
+        }
+        else {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            while (true) {
+                if (pos & closed_bit) {
+                    return channel_state::closed;
+                }
+                slot& entry = slots_[pos & mask_];
+                const std::size_t sequence = entry.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                if (diff == 0) {
+                    // fails if another producer took the slot or the channel got closed
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        ::new (static_cast<void*>(entry.storage)) result_type(std::forward<Args>(args)...);
+                        entry.sequence.store(pos + 1, std::memory_order_release);
+                        return channel_state::ok;
+                    }
+                }
+                else if (diff < 0) {
+                    // the slot still holds the result of the previous round
+                    return channel_state::full;
+                }
+                else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    /// Waits for a free slot, returns false if the channel is closed.
+    template <typename... Args>
+    inline bool push(Args&&... args) {
+        if constexpr (Mode == channel_mode::mpmc && !std::is_nothrow_constructible_v<result_type, Args&&...>) {
+            return push(result_type(std::forward<Args>(args)...));
+        }
+
+        detail::channel_backoff backoff;
+        while (true) {
+            // arguments are only forwarded on the attempt which constructs the result
+            const channel_state state = try_push(std::forward<Args>(args)...);
+            if (state != channel_state::full) {
+                return state == channel_state::ok;
+            }
+            backoff.wait();
+        }
+    }
+
+    /// Next result, the close error once closed and empty, nothing if empty.
+    [[nodiscard]]
+    inline std::optional<result_type> try_pop() {
+        if constexpr (Mode == channel_mode::spsc) {
+            const std::size_t pos = head_.load(std::memory_order_relaxed);
+            if (pos == cached_tail_) {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (pos == cached_tail_) {
+                    if (!closed_.load(std::memory_order_acquire)) {
+                        return std::nullopt;
+                    }
+                    // the producer closes after its last push
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                    if (pos == cached_tail_) {
+                        return close_result();
+                    }
+                }
+            }
+            std::optional<result_type> res(take(slots_[pos & mask_]));
+            head_.store(pos + 1, std::memory_order_release);
+            return res;
+        }
+        else {
+            detail::channel_backoff backoff;
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            while (true) {
+                slot& entry = slots_[pos & mask_];
+                const std::size_t sequence = entry.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+                if (diff == 0) {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        std::optional<result_type> res(take(entry));
+                        entry.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return res;
+                    }
+                }
+                else if (diff < 0) {
+                    const std::size_t tail = tail_.load(std::memory_order_acquire);
+                    if ((tail & ~closed_bit) == pos) {
+                        if (tail & closed_bit) {
+                            return close_result();
+                        }
+                        return std::nullopt;
+                    }
+                    // a producer claimed the slot and is still constructing the result
+                    backoff.wait();
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+                else {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    /// Waits for the next result, returns the close error once closed and empty.
+    [[nodiscard]]
+    inline result_type pop() {
+        detail::channel_backoff backoff;
+        while (true) {
+            if (auto res = try_pop()) {
+                return std::move(*res);
+            }
+            backoff.wait();
+        }
+    }
+
+    /// Closes the channel with a terminal error, returns false if it was already closed.
+    template <typename... Args>
+    inline bool close(Args&&... args) {
+        if (closing_.exchange(true, std::memory_order_relaxed)) {
+            return false;
+        }
+        close_error_.emplace(std::forward<Args>(args)...);
+        if constexpr (Mode == channel_mode::spsc) {
+            closed_.store(true, std::memory_order_release);
+        }
+        else {
+            tail_.fetch_or(closed_bit, std::memory_order_release);
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    inline bool is_closed() const noexcept {
+        if constexpr (Mode == channel_mode::spsc) {
+            return closed_.load(std::memory_order_acquire);
+        }
+        else {
+            return (tail_.load(std::memory_order_acquire) & closed_bit) != 0;
+        }
+    }
+};
+
+template <typename T, typename E>
+using spsc_result_channel = result_channel<T, E, channel_mode::spsc>;
+}
+
+#endif //RESCPP_CHANNEL_H
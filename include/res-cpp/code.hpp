@@ -0,0 +1,205 @@
+#ifndef RESCPP_CODE_H
+#define RESCPP_CODE_H
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+
+#include "res-cpp.hpp"
+
+// 32 bit error code made of a category and a value, 'result<T, rescpp::code>' stays register sized.
+// Values are stored in 24 bits, enums with a signed underlying type get sign extended when read back,
+// so values between -2^23 and 2^23 - 1 (unsigned: up to 2^24 - 1) round trip, others 'assert'.
+// Every enum with a 'code_category' specialization converts to a code,
+// so results with the enum as error get converted without any mapping code.
+//
+//   enum class io_error { not_found = 1, denied };
+//
+//   template <>
+//   struct rescpp::code_category<io_error> {
+//       static constexpr std::uint8_t id = 1;
+//       static constexpr std::string_view name = "io";
+//
+//       static constexpr std::string_view message(io_error error) noexcept {
+//           return error == io_error::not_found ? "not found" : "denied";
+//       }
+//   };
+//
+//   rescpp::result<int, rescpp::code> open_config() {
+//       auto fd = RESCPP_TRY(open_file("config")); // result<int, io_error>
+//       ...
+//   }
+
+namespace rescpp {
+/// Specialization point for enums usable as 'code'.
+/// - 'id' unique category id, '0' is reserved
+/// - 'name' category name
+/// - 'message(Enum)' message for a value, only called when requested
+template <typename Enum>
+struct code_category;
+
+namespace detail {
+template <typename Enum>
+concept code_enum = std::is_enum_v<Enum> && requires(Enum value) {
+    { code_category<Enum>::id } -> std::convertible_to<std::uint8_t>;
+    { code_category<Enum>::name } -> std::convertible_to<std::string_view>;
+    { code_category<Enum>::message(value) } noexcept -> std::convertible_to<std::string_view>;
+};
+
+inline constexpr std::uint32_t code_value_bits = 24;
+inline constexpr std::uint32_t code_value_mask = (1u << code_value_bits) - 1;
+
+/// 'value' fits into the 24 bits of a code
+template <typename Enum>
+[[nodiscard]]
+inline constexpr bool code_value_fits(Enum value) noexcept {
+    using underlying = std::underlying_type_t<Enum>;
+    const auto number = static_cast<underlying>(value);
+    if constexpr (sizeof(underlying) * 8 <= code_value_bits) {
+        return true;
+    }
+    else if constexpr (std::is_signed_v<underlying>) {
+        constexpr underlying limit = underlying(1) << (code_value_bits - 1);
+        return number >= -limit && number < limit;
+    }
+    else {
+        return number <= code_value_mask;
+    }
+}
+
+/// the 24 bits of a code as 'Enum', sign extended for signed underlying types
+template <typename Enum>
+[[nodiscard]]
+inline constexpr Enum code_value_as(std::uint32_t bits) noexcept {
+    using underlying = std::underlying_type_t<Enum>;
+    if constexpr (std::is_signed_v<underlying>) {
+        return static_cast<Enum>(static_cast<underlying>(static_cast<std::int32_t>(bits << (32 - code_value_bits))
+                                                         >> (32 - code_value_bits)));
+    }
+    else {
+        return static_cast<Enum>(static_cast<underlying>(bits));
+    }
+}
+
+struct code_category_entry {
+    std::string_view name;
+    std::string_view (*message)(std::uint32_t value) noexcept;
+};
+
+/// Categories by id, filled before 'main' by every category used to construct a code.
+inline constinit const code_category_entry* code_categories[256] = {};
+
+inline bool register_code_category(std::uint8_t id, const code_category_entry& entry) noexcept {
+    const code_category_entry*& slot = code_categories[id];
+    if (slot != nullptr && slot != &entry) {
+        std::fprintf(stderr, "rescpp::code category id %u registered twice\n", static_cast<unsigned>(id));
+        std::abort();
+    }
+    slot = &entry;
+    return true;
+}
+
+template <code_enum Enum>
+struct code_category_registration {
+    static_assert(code_category<Enum>::id != 0, "code category id '0' is reserved");
+
+    static inline std::string_view message(std::uint32_t value) noexcept {
+        return code_category<Enum>::message(code_value_as<Enum>(value));
+    }
+
+    static inline constexpr code_category_entry entry{ code_category<Enum>::name, &message };
+
+    static inline const bool registered = register_code_category(code_category<Enum>::id, entry);
+};
+}
+
+class code {
+    // [category: 8 bit][value: 24 bit], category '0' is never a valid code
+    std::uint32_t raw_;
+
+    friend struct niche_traits<code>;
+
+    explicit inline constexpr code(std::uint32_t raw) noexcept
+        : raw_(raw) {}
+
+public:
+    static inline constexpr std::uint32_t value_bits = detail::code_value_bits;
+    static inline constexpr std::uint32_t value_mask = detail::code_value_mask;
+
+    /// values are stored with 24 bits, ones which do not fit 'assert' (fail to compile when constant evaluated)
+    template <detail::code_enum Enum>
+    inline constexpr code(Enum value) noexcept
+        : raw_(static_cast<std::uint32_t>(code_category<Enum>::id) << value_bits
+               | (static_cast<std::uint32_t>(value) & value_mask)) {
+        assert(detail::code_value_fits(value));
+        // referencing the registration instantiates it, which registers the category before 'main'
+        static_cast<void>(&detail::code_category_registration<Enum>::registered);
+    }
+
+    [[nodiscard]]
+    inline constexpr std::uint8_t category() const noexcept {
+        return static_cast<std::uint8_t>(raw_ >> value_bits);
+    }
+
+    /// the stored 24 bits, not sign extended
+    [[nodiscard]]
+    inline constexpr std::uint32_t value() const noexcept {
+        return raw_ & value_mask;
+    }
+
+    [[nodiscard]]
+    inline constexpr std::uint32_t raw() const noexcept {
+        return raw_;
+    }
+
+    template <detail::code_enum Enum>
+    [[nodiscard]]
+    inline constexpr bool is() const noexcept {
+        return category() == code_category<Enum>::id;
+    }
+
+    /// only valid if 'is<Enum>()', sign extended for signed underlying types
+    template <detail::code_enum Enum>
+    [[nodiscard]]
+    inline constexpr Enum as() const noexcept {
+        return detail::code_value_as<Enum>(value());
+    }
+
+    /// looked up in the registry, empty for unknown categories
+    [[nodiscard]]
+    inline std::string_view category_name() const noexcept {
+        const auto* entry = detail::code_categories[category()];
+        return entry != nullptr ? entry->name : std::string_view();
+    }
+
+    /// looked up in the registry, empty for unknown categories
+    [[nodiscard]]
+    inline std::string_view message() const noexcept {
+        const auto* entry = detail::code_categories[category()];
+        return entry != nullptr ? entry->message(value()) : std::string_view();
+    }
+
+    inline constexpr bool operator==(const code& other) const noexcept = default;
+};
+
+static_assert(sizeof(code) == sizeof(std::uint32_t));
+
+template <>
+struct niche_traits<code> {
+    [[nodiscard]]
+    static inline constexpr code niche() noexcept {
+        return code(0u);
+    }
+
+    [[nodiscard]]
+    static inline constexpr bool is_niche(const code& value) noexcept {
+        return value.raw_ == 0;
+    }
+};
+}
+
+#endif //RESCPP_CODE_H
@@ -0,0 +1,128 @@
+#ifndef RESCPP_COLLECT_H
+#define RESCPP_COLLECT_H
+
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "res-cpp.hpp"
+
+// Collects a range of results into a single result, stops at the first error.
+// Values of rvalue results (and of rvalue ranges owning their elements) are moved, never copied.
+// Views and borrowed ranges (e.g. 'std::span') are copied from, like lvalue ranges.
+//
+//   auto parsed = rescpp::collect(lines | std::views::transform(parse_line));
+//   // result<std::vector<line>, parse_error>
+
+namespace rescpp {
+namespace detail {
+template <std::ranges::input_range R>
+using range_result_t = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+template <typename R>
+concept result_range = std::ranges::input_range<R> && is_result_v<range_result_t<R>>;
+
+/// 'R' is an rvalue which owns its elements, views and borrowed ranges (e.g. 'std::span') refer to the callers elements
+template <typename R>
+inline constexpr bool owns_elements_v = !std::is_lvalue_reference_v<R>
+                                        && !std::ranges::borrowed_range<R>
+                                        && !std::ranges::view<std::remove_cvref_t<R>>;
+
+/// element of 'range' as lvalue or rvalue, elements of rvalue ranges owning them get moved
+template <typename R, typename Reference>
+inline constexpr decltype(auto) forward_element(Reference&& element) noexcept {
+    if constexpr (!owns_elements_v<R> || !std::is_lvalue_reference_v<Reference>) {
+        return std::forward<Reference>(element);
+    }
+    else {
+        return std::move(element);
+    }
+}
+
+template <typename Container, typename V>
+inline constexpr void append(Container& container, V&& value) {
+    if constexpr (requires { container.push_back(std::forward<V>(value)); }) {
+        container.push_back(std::forward<V>(value));
+    }
+    else {
+        container.insert(container.end(), std::forward<V>(value));
+    }
+}
+}
+
+/// Collects the values of 'range' into 'Container', or returns the first error.
+template <typename Container, typename R>
+    requires (detail::result_range<R>)
+[[nodiscard]]
+inline constexpr result<Container, typename detail::range_result_t<R>::error_type> collect_into(R&& range) {
+    using error_type = typename detail::range_result_t<R>::error_type;
+
+    Container container;
+    if constexpr (std::ranges::sized_range<R> && requires { container.reserve(std::size_t()); }) {
+        container.reserve(static_cast<std::size_t>(std::ranges::size(range)));
+    }
+
+    for (auto&& element : range) {
+        if (element.has_error()) {
+            return result<Container, error_type>(detail::error,
+                                                 detail::forward_element<R>(std::forward<decltype(element)>(element)).error());
+        }
+        detail::append(container, detail::forward_element<R>(std::forward<decltype(element)>(element)).value());
+    }
+    return result<Container, error_type>(std::in_place, std::move(container));
+}
+
+/// Collects the values of 'range' into a 'std::vector', or returns the first error.
+/// Ranges of 'result<void, E>' collect into 'result<void, E>'.
+template <typename R>
+    requires (detail::result_range<R>)
+[[nodiscard]]
+inline constexpr auto collect(R&& range) {
+    using value_type = typename detail::range_result_t<R>::value_type;
+    using error_type = typename detail::range_result_t<R>::error_type;
+
+    if constexpr (std::is_void_v<value_type>) {
+        for (auto&& element : range) {
+            if (element.has_error()) {
+                return result<void, error_type>(detail::error,
+                                                detail::forward_element<R>(std::forward<decltype(element)>(element)).error());
+            }
+        }
+        return result<void, error_type>();
+    }
+    else {
+        return collect_into<std::vector<std::remove_cvref_t<value_type>>>(std::forward<R>(range));
+    }
+}
+
+template <typename T, typename E>
+struct partitioned {
+    std::vector<T> values;
+    std::vector<E> errors;
+};
+
+/// Splits the values and errors of 'range' in a single pass, keeps their order.
+template <typename R>
+    requires (detail::result_range<R>)
+[[nodiscard]]
+inline constexpr auto partition(R&& range) {
+    using value_type = std::remove_cvref_t<typename detail::range_result_t<R>::value_type>;
+    using error_type = typename detail::range_result_t<R>::error_type;
+    static_assert(!std::is_void_v<value_type>, "can not partition results without value");
+
+    partitioned<value_type, error_type> parts;
+    for (auto&& element : range) {
+        if (element.has_error()) {
+            parts.errors.push_back(detail::forward_element<R>(std::forward<decltype(element)>(element)).error());
+        }
+        else {
+            parts.values.push_back(detail::forward_element<R>(std::forward<decltype(element)>(element)).value());
+        }
+    }
+    return parts;
+}
+}
+
+#endif //RESCPP_COLLECT_H
@@ -0,0 +1,268 @@
+#ifndef RESCPP_COROUTINE_H
+#define RESCPP_COROUTINE_H
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+
+#include "res-cpp.hpp"
+
+// Functions returning 'result<T, E>' can be written as coroutines.
+// 'co_await' on a result returns its value or stops the coroutine
+// and returns the error, converted like a 'failure' would be.
+//
+// The coroutine never suspends, it runs to completion before returning to the caller.
+// Compilers which support heap elision (e.g. clang '-O2') can therefore put the frame
+// on the caller stack. When that does not happen the frame can be allocated through
+// an allocator passed with 'std::allocator_arg' as the first parameters:
+//
+//   rescpp::result<int, error> parse(std::allocator_arg_t, const Alloc&, std::string_view text) {
+//       auto value = co_await parse_int(text);
+//       co_return value * 2;
+//   }
+//
+// 'result<void, E>' coroutines have to end with 'co_return {};' (or 'co_return fail(...)'),
+// a promise can not have 'return_void' next to 'return_value'.
+//
+// The result is built in the object returned by 'get_return_object' and moved out when that object
+// gets converted to 'result'. This needs the conversion to happen after the coroutine body ran,
+// which GCC and Clang do (CWG2563). A compiler converting it right away (e.g. MSVC) would read the result
+// before it was set, 'assert' catches that.
+
+namespace rescpp {
+namespace detail {
+/// Coroutine frames are allocated in blocks, so the allocator can not hand out misaligned memory.
+struct alignas(std::max_align_t) coroutine_frame_block {
+    std::byte data[alignof(std::max_align_t)];
+};
+
+using coroutine_frame_deallocate = void (*)(void* frame, std::size_t size) noexcept;
+
+/// Frame layout: [frame][deallocate function][allocator]
+struct coroutine_frame_layout {
+    [[nodiscard]]
+    static inline constexpr std::size_t align_up(std::size_t size) noexcept {
+        return (size + sizeof(coroutine_frame_block) - 1) / sizeof(coroutine_frame_block)
+            * sizeof(coroutine_frame_block);
+    }
+
+    [[nodiscard]]
+    static inline constexpr std::size_t deallocate_offset(std::size_t size) noexcept {
+        return align_up(size);
+    }
+
+    [[nodiscard]]
+    static inline constexpr std::size_t allocator_offset(std::size_t size) noexcept {
+        return deallocate_offset(size) + align_up(sizeof(coroutine_frame_deallocate));
+    }
+
+    template <typename Alloc>
+    [[nodiscard]]
+    static inline constexpr std::size_t block_count(std::size_t size) noexcept {
+        return align_up(allocator_offset(size) + sizeof(Alloc)) / sizeof(coroutine_frame_block);
+    }
+};
+
+template <typename Alloc>
+using coroutine_frame_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<coroutine_frame_block>;
+
+template <typename Alloc>
+inline void deallocate_coroutine_frame(void* frame, std::size_t size) noexcept {
+    static_assert(alignof(Alloc) <= alignof(coroutine_frame_block),
+                  "over aligned allocators are not supported");
+
+    auto* bytes = static_cast<std::byte*>(frame);
+    auto* stored = reinterpret_cast<Alloc*>(bytes + coroutine_frame_layout::allocator_offset(size));
+    Alloc alloc(std::move(*stored));
+    std::destroy_at(stored);
+
+    std::allocator_traits<Alloc>::deallocate(alloc,
+                                             static_cast<coroutine_frame_block*>(frame),
+                                             coroutine_frame_layout::block_count<Alloc>(size));
+}
+
+template <typename Alloc>
+[[nodiscard]]
+inline void* allocate_coroutine_frame(std::size_t size, const Alloc& alloc) {
+    using frame_allocator = coroutine_frame_allocator<Alloc>;
+
+    frame_allocator frame_alloc(alloc);
+    auto* frame = std::allocator_traits<frame_allocator>::allocate(frame_alloc,
+                                                                   coroutine_frame_layout::block_count<frame_allocator>(size));
+    auto* bytes = reinterpret_cast<std::byte*>(frame);
+
+    std::construct_at(reinterpret_cast<coroutine_frame_deallocate*>(bytes + coroutine_frame_layout::deallocate_offset(size)),
+                      &deallocate_coroutine_frame<frame_allocator>);
+    std::construct_at(reinterpret_cast<frame_allocator*>(bytes + coroutine_frame_layout::allocator_offset(size)),
+                      std::move(frame_alloc));
+    return frame;
+}
+
+inline void free_coroutine_frame(void* frame, std::size_t size) noexcept {
+    auto* bytes = static_cast<std::byte*>(frame);
+    const auto deallocate = *reinterpret_cast<coroutine_frame_deallocate*>(bytes + coroutine_frame_layout::deallocate_offset(size));
+    deallocate(frame, size);
+}
+
+template <typename T, typename E>
+struct result_promise;
+
+/// Returned by 'get_return_object', converted to the 'result' once the coroutine returns to the caller.
+/// The coroutine never suspends, so the result is always set by then.
+template <typename T, typename E>
+struct coroutine_return_object {
+private:
+    union {
+        result<T, E> result_;
+    };
+
+    bool has_result_ = false;
+
+    friend struct result_promise<T, E>;
+
+public:
+    explicit inline coroutine_return_object(result_promise<T, E>& promise) noexcept {
+        promise.return_object_ = this;
+    }
+
+    coroutine_return_object(const coroutine_return_object&) = delete;
+    coroutine_return_object& operator=(const coroutine_return_object&) = delete;
+
+    inline ~coroutine_return_object() noexcept {
+        if (has_result_) {
+            std::destroy_at(std::addressof(result_));
+        }
+    }
+
+    inline operator result<T, E>() && noexcept(std::is_nothrow_move_constructible_v<result<T, E>>) {
+        // converted before the coroutine ran, see top of the file
+        assert(has_result_);
+        return std::move(result_);
+    }
+};
+
+/// Stops the coroutine if the awaited result has an error.
+/// 'R' is a reference to the awaited result, rvalues get moved from.
+template <typename R>
+struct result_awaiter {
+    std::remove_reference_t<R>* result_;
+    // the 'co_await', see 'res-cpp/trace.hpp'
+    [[no_unique_address]] trace_location location_;
+
+    [[nodiscard]]
+    inline bool await_ready() const noexcept {
+        return !result_->has_error();
+    }
+
+    template <typename T, typename E>
+    inline void await_suspend(std::coroutine_handle<result_promise<T, E>> handle) {
+        detail::trace_hop(*result_, location_);
+        detail::stats_propagated<typename std::remove_cvref_t<R>::error_type>();
+        handle.promise().set_result(fail(pass_error, std::forward<R>(*result_)));
+        // nothing of the coroutine is needed anymore, destroying it returns to the caller
+        handle.destroy();
+    }
+
+    inline decltype(auto) await_resume() RESCPP_CHECKS_NOEXCEPT {
+        if constexpr (!std::is_void_v<typename std::remove_cvref_t<R>::value_type>) {
+            return std::forward<R>(*result_).value();
+        }
+    }
+};
+
+template <typename T, typename E>
+struct result_promise {
+private:
+    coroutine_return_object<T, E>* return_object_ = nullptr;
+
+    friend struct coroutine_return_object<T, E>;
+
+public:
+    [[nodiscard]]
+    static inline void* operator new(std::size_t size) {
+        return allocate_coroutine_frame(size, std::allocator<coroutine_frame_block>());
+    }
+
+    template <typename Alloc, typename... Args>
+    [[nodiscard]]
+    static inline void* operator new(std::size_t size, std::allocator_arg_t, const Alloc& alloc, const Args&...) {
+        return allocate_coroutine_frame(size, alloc);
+    }
+
+    // member function coroutines, 'this' is the first parameter
+    template <typename This, typename Alloc, typename... Args>
+    [[nodiscard]]
+    static inline void* operator new(std::size_t size, const This&, std::allocator_arg_t, const Alloc& alloc, const Args&...) {
+        return allocate_coroutine_frame(size, alloc);
+    }
+
+    static inline void operator delete(void* frame, std::size_t size) noexcept {
+        free_coroutine_frame(frame, size);
+    }
+
+    [[nodiscard]]
+    inline coroutine_return_object<T, E> get_return_object() noexcept {
+        return coroutine_return_object<T, E>(*this);
+    }
+
+    [[nodiscard]]
+    inline std::suspend_never initial_suspend() const noexcept {
+        return {};
+    }
+
+    [[nodiscard]]
+    inline std::suspend_never final_suspend() const noexcept {
+        return {};
+    }
+
+    inline void set_result(result<T, E>&& value) noexcept(std::is_nothrow_move_constructible_v<result<T, E>>) {
+        std::construct_at(std::addressof(return_object_->result_), std::move(value));
+        return_object_->has_result_ = true;
+    }
+
+    inline void return_value(result<T, E> value) noexcept(std::is_nothrow_move_constructible_v<result<T, E>>) {
+        set_result(std::move(value));
+    }
+
+    [[noreturn]]
+    inline void unhandled_exception() const {
+#if defined(__cpp_exceptions)
+        throw;
+#else
+        std::terminate();
+#endif
+    }
+
+    template <typename T2, typename E2>
+    [[nodiscard]]
+    inline result_awaiter<result<T2, E2>&> await_transform(result<T2, E2>& value,
+                                                           trace_location location = trace_location::current()) const noexcept {
+        return { std::addressof(value), location };
+    }
+
+    template <typename T2, typename E2>
+    [[nodiscard]]
+    inline result_awaiter<const result<T2, E2>&> await_transform(const result<T2, E2>& value,
+                                                                 trace_location location = trace_location::current()) const noexcept {
+        return { std::addressof(value), location };
+    }
+
+    // the awaited temporary lives until the end of the full expression, no need to move it
+    template <typename T2, typename E2>
+    [[nodiscard]]
+    inline result_awaiter<result<T2, E2>&&> await_transform(result<T2, E2>&& value,
+                                                            trace_location location = trace_location::current()) const noexcept {
+        return { std::addressof(value), location };
+    }
+};
+}
+}
+
+template <typename T, typename E, typename... Args>
+struct std::coroutine_traits<rescpp::result<T, E>, Args...> {
+    using promise_type = rescpp::detail::result_promise<T, E>;
+};
+
+#endif //RESCPP_COROUTINE_H
@@ -0,0 +1,220 @@
+#ifndef RESCPP_ENUM_MAP_H
+#define RESCPP_ENUM_MAP_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "res-cpp.hpp"
+
+// Declarative mapping of one error enum onto another, used as 'type_converter' instead of a 'switch'.
+// The conversion is a single load from a table built at compile time,
+// or an addition if every pair has the same distance (an identity mapping is just a cast).
+// Every enumerator of 'From' needs a pair, a missing one fails to compile
+// (the error names it as 'enum_map_check<From::value, false>').
+//
+//   template <>
+//   struct rescpp::type_converter<io_error, app_error> : rescpp::enum_map<io_error, app_error,
+//       rescpp::enum_pair<io_error::not_found, app_error::missing>,
+//       rescpp::enum_pair<io_error::denied, app_error::forbidden>> {};
+//
+// Enumerators are found by their names in '__PRETTY_FUNCTION__' (GCC and Clang, no check otherwise),
+// values between the smallest and largest pair and between 'RESCPP_ENUM_MAP_SCAN_MIN' and 'RESCPP_ENUM_MAP_SCAN_MAX'
+// are checked, enumerators outside of both are not found.
+// Clang rejects casting a value outside of the range of an unscoped enum without a fixed underlying type,
+// there those are only checked in the smallest bit field holding every pair.
+// Converting a value without a pair calls 'std::abort', unless 'RESCPP_DISABLE_CHECKS' is set.
+
+#ifndef RESCPP_ENUM_MAP_SCAN_MIN
+#define RESCPP_ENUM_MAP_SCAN_MIN (-128)
+#endif
+
+#ifndef RESCPP_ENUM_MAP_SCAN_MAX
+#define RESCPP_ENUM_MAP_SCAN_MAX 255
+#endif
+
+#ifndef RESCPP_ENUM_MAP_MAX_TABLE
+#define RESCPP_ENUM_MAP_MAX_TABLE 4096
+#endif
+
+namespace rescpp {
+/// 'From' maps to 'To'
+template <auto From, auto To>
+    requires (std::is_enum_v<decltype(From)> && std::is_enum_v<decltype(To)>)
+struct enum_pair {
+    static inline constexpr auto from = From;
+    static inline constexpr auto to = To;
+};
+
+namespace detail {
+template <typename Enum>
+inline constexpr std::intmax_t enum_value(Enum value) noexcept {
+    return static_cast<std::intmax_t>(static_cast<std::underlying_type_t<Enum>>(value));
+}
+
+template <auto Value>
+inline constexpr bool is_enumerator() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    // named values print as 'Value = ns::error::name', others as 'Value = (ns::error)5'
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    constexpr std::size_t start = signature.find("Value = ");
+    return start != std::string_view::npos && signature[start + 8] != '(';
+#else
+    return true;
+#endif
+}
+
+/// fails to compile for an enumerator without a pair, the error names it
+template <auto Value, bool Listed>
+struct enum_map_check {
+    static_assert(Listed, "'enum_map' has no pair for the enumerator 'Value'");
+    static inline constexpr bool value = Listed;
+};
+
+/// 2^n of the smallest bit field holding 'min' and 'max', the values of an enum without a fixed underlying type
+[[nodiscard]]
+inline constexpr std::intmax_t enum_bit_field_limit(std::intmax_t min, std::intmax_t max) noexcept {
+    std::intmax_t limit = 1;
+    while (limit <= max || -limit > min) {
+        limit *= 2;
+    }
+    return limit;
+}
+
+template <typename From, typename... Pairs>
+struct enum_map_range {
+    static inline constexpr std::intmax_t min = std::min({ enum_value(Pairs::from)... });
+    static inline constexpr std::intmax_t max = std::max({ enum_value(Pairs::from)... });
+
+    // scoped enums and 'enum E : int' can hold every value of their underlying type
+    static inline constexpr bool fixed = requires { From{ std::underlying_type_t<From>{} }; };
+    using limits = std::numeric_limits<std::underlying_type_t<From>>;
+
+#if defined(__clang__)
+    static inline constexpr bool bit_field = !fixed;
+#else
+    static inline constexpr bool bit_field = false;
+#endif
+
+    static inline constexpr std::intmax_t scan_min = bit_field ? (min < 0 ? -enum_bit_field_limit(min, max) : 0)
+        : std::min(min, std::max<std::intmax_t>(RESCPP_ENUM_MAP_SCAN_MIN, static_cast<std::intmax_t>(limits::min())));
+    static inline constexpr std::intmax_t scan_max = bit_field ? enum_bit_field_limit(min, max) - 1
+        : std::max(max, static_cast<std::intmax_t>(std::min<std::uintmax_t>(RESCPP_ENUM_MAP_SCAN_MAX, limits::max())));
+};
+
+template <typename From, typename... Pairs>
+inline constexpr bool enum_map_listed(std::intmax_t value) noexcept {
+    return ((enum_value(Pairs::from) == value) || ...);
+}
+
+template <typename From, std::intmax_t Min, typename... Pairs, std::size_t... I>
+inline constexpr bool enum_map_complete(std::index_sequence<I...>) noexcept {
+    return (enum_map_check<static_cast<From>(Min + static_cast<std::intmax_t>(I)),
+                           !is_enumerator<static_cast<From>(Min + static_cast<std::intmax_t>(I))>()
+                           || enum_map_listed<From, Pairs...>(Min + static_cast<std::intmax_t>(I))>::value && ...);
+}
+
+/// 'enum_map_complete' without failing to compile
+template <typename From, std::intmax_t Min, typename... Pairs, std::size_t... I>
+inline constexpr bool enum_map_covers(std::index_sequence<I...>) noexcept {
+    return ((!is_enumerator<static_cast<From>(Min + static_cast<std::intmax_t>(I))>()
+             || enum_map_listed<From, Pairs...>(Min + static_cast<std::intmax_t>(I))) && ...);
+}
+
+/// every enumerator of 'From' found in the scanned range has a pair
+template <typename From, typename... Pairs>
+inline constexpr bool enum_map_covers_v = enum_map_covers<From, enum_map_range<From, Pairs...>::scan_min, Pairs...>(
+    std::make_index_sequence<static_cast<std::size_t>(enum_map_range<From, Pairs...>::scan_max
+                                                      - enum_map_range<From, Pairs...>::scan_min + 1)>());
+
+[[noreturn, gnu::cold, gnu::noinline]]
+inline void enum_map_unmapped_value(std::intmax_t value) noexcept {
+    std::fprintf(stderr, "'enum_map' has no pair for the value %jd\n", value);
+    std::abort();
+}
+
+template <typename From, typename... Pairs>
+inline constexpr bool enum_map_unique() noexcept {
+    constexpr std::array<std::intmax_t, sizeof...(Pairs)> values{ enum_value(Pairs::from)... };
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        for (std::size_t j = i + 1; j < values.size(); ++j) {
+            if (values[i] == values[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// every pair has the same distance between its values, no table needed
+template <typename... Pairs>
+inline constexpr bool enum_map_same_offset() noexcept {
+    constexpr std::array<std::intmax_t, sizeof...(Pairs)> offsets{ (enum_value(Pairs::to) - enum_value(Pairs::from))... };
+    return std::all_of(offsets.begin(), offsets.end(), [&](std::intmax_t offset) { return offset == offsets[0]; });
+}
+}
+
+/// 'type_converter' from the enum 'From' to the enum 'To', see top of the file.
+template <typename From, typename To, typename... Pairs>
+struct enum_map {
+    static_assert(std::is_enum_v<From> && std::is_enum_v<To>, "'enum_map' maps an enum onto another one");
+    static_assert(sizeof...(Pairs) > 0, "'enum_map' needs at least one pair");
+    static_assert((std::is_same_v<std::remove_const_t<decltype(Pairs::from)>, From> && ...),
+                  "every pair has to map from 'From'");
+    static_assert((std::is_same_v<std::remove_const_t<decltype(Pairs::to)>, To> && ...),
+                  "every pair has to map to 'To'");
+    static_assert(detail::enum_map_unique<From, Pairs...>(), "'enum_map' has more than one pair for an enumerator");
+
+private:
+    using range = detail::enum_map_range<From, Pairs...>;
+    using first = std::tuple_element_t<0, std::tuple<Pairs...>>;
+
+    static_assert(detail::enum_map_complete<From, range::scan_min, Pairs...>(
+        std::make_index_sequence<static_cast<std::size_t>(range::scan_max - range::scan_min + 1)>()));
+
+    static inline constexpr bool same_offset = detail::enum_map_same_offset<Pairs...>();
+
+    static inline constexpr std::size_t table_size = static_cast<std::size_t>(range::max - range::min + 1);
+    static_assert(same_offset || table_size <= RESCPP_ENUM_MAP_MAX_TABLE,
+                  "'From' values are too far apart for a table, raise 'RESCPP_ENUM_MAP_MAX_TABLE'");
+
+    static inline constexpr auto table = [] {
+        // values between the pairs which are no enumerator keep the first target, they can't be converted
+        std::array<To, same_offset ? 1 : table_size> result{};
+        result.fill(first::to);
+        if constexpr (!same_offset) {
+            ((result[static_cast<std::size_t>(detail::enum_value(Pairs::from) - range::min)] = Pairs::to), ...);
+        }
+        return result;
+    }();
+
+public:
+    /// only enumerators of 'From' can be converted, values outside of the pairs abort (see top of the file)
+    [[nodiscard]]
+    static inline constexpr To convert(const From& from) noexcept {
+        using to_type = std::underlying_type_t<To>;
+#ifndef RESCPP_DISABLE_CHECKS
+        if (detail::enum_value(from) < range::min || detail::enum_value(from) > range::max) {
+            detail::enum_map_unmapped_value(detail::enum_value(from));
+        }
+#endif
+        if constexpr (same_offset) {
+            constexpr std::intmax_t offset = detail::enum_value(first::to) - detail::enum_value(first::from);
+            return static_cast<To>(static_cast<to_type>(detail::enum_value(from) + offset));
+        }
+        else {
+            return table[static_cast<std::size_t>(detail::enum_value(from) - range::min)];
+        }
+    }
+};
+}
+
+#endif //RESCPP_ENUM_MAP_H
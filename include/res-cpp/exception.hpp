@@ -0,0 +1,231 @@
+#ifndef RESCPP_EXCEPTION_H
+#define RESCPP_EXCEPTION_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "res-cpp.hpp"
+
+// Bridge between exceptions and results at API boundaries.
+//
+// 'catch_as_result<E>(f, mappers...)' calls 'f' and returns its value (or result) as 'result<T, E>'.
+// Thrown exceptions get mapped to an error by the first matching mapper, unmatched ones propagate:
+// - 'rescpp::map_exception<Ex>' catches 'Ex', converted with a constructor or 'type_converter<Ex, E>'
+// - a function taking one exception, e.g. '[](const std::out_of_range& ex) { return error::range; }'
+// - a function taking nothing catches everything, e.g. '[] { return error::unknown; }'
+// The only handler is a 'catch (...)' which calls the mapping out of line,
+// so the non throwing path stays a plain call of 'f'.
+//
+// 'value_or_throw(result)' returns the value or throws the error as 'error_exception<E>',
+// 'value_or_throw<Ex>(result)' throws the error converted to 'Ex'.
+//
+//   auto port = rescpp::catch_as_result<config_error>(
+//       [&] { return std::stoi(text); },
+//       rescpp::map_exception<std::out_of_range>,
+//       [](const std::invalid_argument&) { return config_error::not_a_number; });
+//
+//   int value = rescpp::value_or_throw(parse(text));
+
+namespace rescpp {
+/// Maps 'Ex' to the error with a constructor of the error or 'type_converter<Ex, E>'.
+template <typename Ex>
+struct map_exception_t {};
+
+template <typename Ex>
+inline constexpr map_exception_t<Ex> map_exception{};
+
+/// The error of a result, thrown by 'value_or_throw'.
+template <typename E>
+class error_exception : public std::exception {
+    E error_;
+
+public:
+    explicit inline error_exception(const E& error)
+        : error_(error) {}
+
+    explicit inline error_exception(E&& error)
+        : error_(std::move(error)) {}
+
+    [[nodiscard]]
+    inline const E& error() const & noexcept {
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline E&& error() && noexcept {
+        return std::move(error_);
+    }
+
+    [[nodiscard]]
+    inline const char* what() const noexcept override {
+        return "result holds an error";
+    }
+};
+
+namespace detail {
+/// exception caught by a mapper, 'void' for mappers which catch everything
+template <typename M>
+struct mapper_exception : mapper_exception<decltype(&M::operator())> {};
+
+template <typename Ex>
+struct mapper_exception<map_exception_t<Ex>> {
+    using type = Ex;
+};
+
+template <typename R, typename A>
+struct mapper_exception<R (*)(A)> {
+    using type = std::remove_cvref_t<A>;
+};
+
+template <typename R>
+struct mapper_exception<R (*)()> {
+    using type = void;
+};
+
+template <typename R, typename C, typename... A>
+struct mapper_exception<R (C::*)(A...) const> : mapper_exception<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct mapper_exception<R (C::*)(A...) const noexcept> : mapper_exception<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct mapper_exception<R (C::*)(A...)> : mapper_exception<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct mapper_exception<R (C::*)(A...) noexcept> : mapper_exception<R (*)(A...)> {};
+
+template <typename R, typename... A>
+struct mapper_exception<R (*)(A...) noexcept> : mapper_exception<R (*)(A...)> {};
+
+template <typename R, typename... A>
+struct mapper_exception<R(A...)> : mapper_exception<R (*)(A...)> {};
+
+template <typename M>
+using mapper_exception_t = typename mapper_exception<std::remove_cvref_t<M>>::type;
+
+template <typename E, typename Ex, typename M>
+inline E map_with(const M& mapper, const Ex& exception) {
+    if constexpr (std::is_same_v<M, map_exception_t<Ex>>) {
+        return convert_error<E>(exception);
+    }
+    else {
+        return convert_error<E>(std::invoke(mapper, exception));
+    }
+}
+
+#if defined(__cpp_exceptions)
+/// Maps the exception currently handled, rethrows it if no mapper matches.
+/// Only called from a handler, the rethrow and the type matching stay out of the caller.
+template <typename E, typename M, typename... Rest>
+[[gnu::cold, gnu::noinline]]
+inline E map_current_exception(const M& mapper, const Rest&... rest) {
+    using exception_type = mapper_exception_t<M>;
+    if constexpr (std::is_void_v<exception_type>) {
+        return convert_error<E>(std::invoke(mapper));
+    }
+    else {
+        try {
+            throw;
+        }
+        catch (const exception_type& exception) {
+            return map_with<E>(mapper, exception);
+        }
+        catch (...) {
+            if constexpr (sizeof...(Rest) == 0) {
+                throw;
+            }
+            else {
+                return map_current_exception<E>(rest...);
+            }
+        }
+    }
+}
+#endif
+
+/// 'result<T, E>' for functions returning 'T' or a result with value 'T'
+template <typename E, typename V>
+struct catch_result {
+    using type = result<V, E>;
+};
+
+template <typename E, typename T, typename E2>
+struct catch_result<E, result<T, E2>> {
+    using type = result<T, E>;
+};
+
+template <typename E, typename F>
+using catch_result_t = typename catch_result<E, std::invoke_result_t<F>>::type;
+
+template <typename R, typename F>
+inline R invoke_as_result(F&& f) {
+    if constexpr (is_result_v<std::invoke_result_t<F>>) {
+        return R(std::invoke(std::forward<F>(f)));
+    }
+    else if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+        std::invoke(std::forward<F>(f));
+        return R();
+    }
+    else {
+        return R(std::in_place, std::invoke(std::forward<F>(f)));
+    }
+}
+
+template <typename Ex, typename E>
+[[noreturn, gnu::cold, gnu::noinline]]
+inline void throw_error(E&& error) {
+#if defined(RESCPP_DISABLE_EXCEPTIONS) || !defined(__cpp_exceptions)
+    static_cast<void>(error);
+    std::fprintf(stderr, "value_or_throw on a result holding an error");
+    std::abort();
+#else
+    throw convert_error<Ex>(std::forward<E>(error));
+#endif
+}
+}
+
+/// Calls 'f', maps exceptions it throws to 'E' with the first matching mapper, see top of the file.
+template <typename E, typename F, typename... Mappers>
+inline detail::catch_result_t<E, F> catch_as_result(F&& f, [[maybe_unused]] const Mappers&... mappers) {
+    static_assert(sizeof...(Mappers) > 0, "'catch_as_result' needs at least one mapper");
+    using result_type = detail::catch_result_t<E, F>;
+#if defined(__cpp_exceptions)
+    try {
+        return detail::invoke_as_result<result_type>(std::forward<F>(f));
+    }
+    catch (...) {
+        return fail(detail::map_current_exception<E>(mappers...));
+    }
+#else
+    return detail::invoke_as_result<result_type>(std::forward<F>(f));
+#endif
+}
+
+/// Value of 'res', throws its error as 'Ex' ('error_exception<E>' by default) otherwise.
+/// Values of rvalue results are returned by value.
+template <typename Ex = void, typename R>
+    requires (detail::is_result_v<std::remove_cvref_t<R>>)
+inline decltype(auto) value_or_throw(R&& res) {
+    using error_type = detail::result_error_t<R>;
+    using value_type = detail::result_value_t<R>;
+    using exception_type = std::conditional_t<std::is_void_v<Ex>, error_exception<error_type>, Ex>;
+
+    if (res.has_error()) [[unlikely]] {
+        detail::throw_error<exception_type>(std::forward<R>(res).error());
+    }
+    if constexpr (std::is_void_v<value_type>) {
+        return;
+    }
+    else if constexpr (std::is_lvalue_reference_v<R> || std::is_reference_v<value_type>) {
+        return std::forward<R>(res).value();
+    }
+    else {
+        return value_type(std::forward<R>(res).value());
+    }
+}
+}
+
+#endif //RESCPP_EXCEPTION_H
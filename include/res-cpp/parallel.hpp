@@ -0,0 +1,384 @@
+#ifndef RESCPP_PARALLEL_H
+#define RESCPP_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "res-cpp.hpp"
+
+// Parallel transform over result returning functions.
+// 'parallel_transform(range, f)' splits 'range' into chunks which run on a work stealing 'thread_pool',
+// the calling thread helps until every chunk is done. Once an element fails, chunks stop
+// before elements behind it, elements in front still run, so the returned error is always
+// the one with the lowest index, the same as a sequential loop would return.
+//
+//   rescpp::result<std::vector<image>, decode_error> images = rescpp::parallel_transform(files, decode);
+
+namespace rescpp {
+class thread_pool;
+
+namespace detail {
+struct pool_worker {
+    thread_pool* pool = nullptr;
+    std::size_t index = 0;
+};
+
+/// pool and queue of the worker running on this thread
+inline thread_local pool_worker current_pool_worker;
+}
+
+/// Thread pool with one task queue per worker.
+/// Workers take their newest task first and steal the oldest task of the others when theirs is empty.
+class thread_pool {
+    struct task_queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<task_queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::size_t> pending_ = 0;
+    std::atomic<std::size_t> next_queue_ = 0;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+
+    [[nodiscard]]
+    inline std::optional<std::function<void()>> take_task(std::size_t first_queue, bool newest) {
+        for (std::size_t i = 0; i < queues_.size(); ++i) {
+            task_queue& queue = *queues_[(first_queue + i) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+
+            // only the own queue is taken from the back
+            std::function<void()> task;
+            if (newest && i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    inline void work(std::size_t index) {
+        detail::current_pool_worker = detail::pool_worker{ this, index };
+        while (true) {
+            if (run_pending_task()) {
+                continue;
+            }
+
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] {
+                return stopping_ || pending_.load(std::memory_order_relaxed) > 0;
+            });
+            if (stopping_ && pending_.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit inline thread_pool(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(threads, 1);
+        queues_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<task_queue>());
+        }
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /// runs the remaining tasks, then joins the workers
+    inline ~thread_pool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    /// pool used by 'parallel_transform' without an explicit pool, one worker per hardware thread
+    [[nodiscard]]
+    static inline thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    [[nodiscard]]
+    inline std::size_t size() const noexcept {
+        return threads_.size();
+    }
+
+    /// Queues 'task', workers of this pool queue into their own queue, other threads spread them over all queues.
+    inline void submit(std::function<void()> task) {
+        const auto& worker = detail::current_pool_worker;
+        const std::size_t index = worker.pool == this
+                                      ? worker.index
+                                      : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        // counted before it is queued so 'pending_' never drops below zero
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(queues_[index]->mutex);
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                queues_[index]->tasks.push_back(std::move(task));
+#if defined(__cpp_exceptions)
+            }
+            catch (...) {
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                throw;
+            }
+#endif
+        }
+
+        {
+            // waiters check 'pending_' under the lock, taking it here means no wake up is lost
+            std::lock_guard lock(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    /// Runs one queued task on the calling thread, returns false if there was none.
+    inline bool run_pending_task() {
+        const auto& worker = detail::current_pool_worker;
+        const bool own = worker.pool == this;
+        auto task = take_task(own ? worker.index : 0, own);
+        if (!task.has_value()) {
+            return false;
+        }
+        (*task)();
+        return true;
+    }
+};
+
+namespace detail {
+template <typename R, typename F>
+using parallel_result_t = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>;
+
+/// Values written by index from several threads, 'std::optional' slots if 'T' can not be default constructed.
+/// 'bool' always uses slots, the bits of 'std::vector<bool>' can not be written concurrently.
+template <typename T>
+class parallel_values {
+    static inline constexpr bool direct = std::is_default_constructible_v<T> && std::is_move_assignable_v<T>
+        && !std::is_same_v<T, bool>;
+
+    std::conditional_t<direct, std::vector<T>, std::vector<std::optional<T>>> slots_;
+
+public:
+    explicit inline parallel_values(std::size_t size)
+        : slots_(size) {}
+
+    template <typename V>
+    inline void set(std::size_t index, V&& value) {
+        if constexpr (direct) {
+            slots_[index] = std::forward<V>(value);
+        }
+        else {
+            slots_[index].emplace(std::forward<V>(value));
+        }
+    }
+
+    [[nodiscard]]
+    inline std::vector<T> take() && {
+        if constexpr (direct) {
+            return std::move(slots_);
+        }
+        else {
+            std::vector<T> values;
+            values.reserve(slots_.size());
+            for (auto& slot : slots_) {
+                values.push_back(std::move(*slot));
+            }
+            return values;
+        }
+    }
+};
+
+template <typename E>
+class parallel_error {
+    // index of the first error found so far, elements behind it get skipped
+    std::atomic<std::size_t> index_ = static_cast<std::size_t>(-1);
+    std::mutex mutex_;
+    std::optional<E> error_;
+    std::exception_ptr exception_;
+
+public:
+    [[nodiscard]]
+    inline bool skips(std::size_t index) const noexcept {
+        return index > index_.load(std::memory_order_relaxed);
+    }
+
+    template <typename Err>
+    inline void fail(std::size_t index, Err&& error) {
+        std::lock_guard lock(mutex_);
+        if (index < index_.load(std::memory_order_relaxed)) {
+            index_.store(index, std::memory_order_relaxed);
+            error_.emplace(std::forward<Err>(error));
+            exception_ = nullptr;
+        }
+    }
+
+    /// exceptions of 'f' cancel like errors, the one with the lowest index is rethrown
+    inline void fail_with_exception(std::size_t index, std::exception_ptr exception) {
+        std::lock_guard lock(mutex_);
+        if (index < index_.load(std::memory_order_relaxed)) {
+            index_.store(index, std::memory_order_relaxed);
+            error_.reset();
+            exception_ = std::move(exception);
+        }
+    }
+
+    [[nodiscard]]
+    inline bool failed() const noexcept {
+        return index_.load(std::memory_order_relaxed) != static_cast<std::size_t>(-1);
+    }
+
+    inline void rethrow() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+    [[nodiscard]]
+    inline E take() && {
+        return std::move(*error_);
+    }
+};
+}
+
+/// Calls 'f' with every element of 'range' on 'pool', returns all values in order or the error with the lowest index.
+/// 'chunk_size' elements run as one task, '0' picks a size giving each worker a few chunks.
+template <typename R, typename F>
+    requires (std::ranges::random_access_range<R> && std::ranges::sized_range<R>
+              && detail::is_result_v<detail::parallel_result_t<R, F>>)
+[[nodiscard]]
+inline auto parallel_transform(thread_pool& pool, R&& range, F&& f, std::size_t chunk_size = 0) {
+    using function_result = detail::parallel_result_t<R, F>;
+    using value_type = typename function_result::value_type;
+    using error_type = typename function_result::error_type;
+    using result_type = std::conditional_t<std::is_void_v<value_type>,
+                                           result<void, error_type>,
+                                           result<std::vector<std::remove_cvref_t<value_type>>, error_type>>;
+
+    const auto size = static_cast<std::size_t>(std::ranges::size(range));
+    if (chunk_size == 0) {
+        chunk_size = std::max<std::size_t>(size / (pool.size() * 4), 1);
+    }
+    const std::size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+
+    [[maybe_unused]] auto values = [size] {
+        if constexpr (std::is_void_v<value_type>) {
+            return 0;
+        }
+        else {
+            return detail::parallel_values<std::remove_cvref_t<value_type>>(size);
+        }
+    }();
+    detail::parallel_error<error_type> error;
+    std::latch done(static_cast<std::ptrdiff_t>(chunk_count));
+
+    const auto first = std::ranges::begin(range);
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+#if defined(__cpp_exceptions)
+        try {
+#endif
+            pool.submit([&, chunk] {
+                const std::size_t begin = chunk * chunk_size;
+                const std::size_t end = std::min(begin + chunk_size, size);
+                for (std::size_t index = begin; index < end && !error.skips(index); ++index) {
+#if defined(__cpp_exceptions)
+                    try {
+#endif
+                        auto res = std::invoke(f, first[static_cast<std::ranges::range_difference_t<R>>(index)]);
+                        if (res.has_error()) {
+                            error.fail(index, std::move(res).error());
+                            break;
+                        }
+                        if constexpr (!std::is_void_v<value_type>) {
+                            values.set(index, std::move(res).value());
+                        }
+#if defined(__cpp_exceptions)
+                    }
+                    catch (...) {
+                        error.fail_with_exception(index, std::current_exception());
+                        break;
+                    }
+#endif
+                }
+                done.count_down();
+            });
+#if defined(__cpp_exceptions)
+        }
+        catch (...) {
+            // queued chunks refer to this frame, they get cancelled and waited for below before the exception
+            // is rethrown, chunks never submitted count as done
+            error.fail_with_exception(0, std::current_exception());
+            done.count_down(static_cast<std::ptrdiff_t>(chunk_count - chunk));
+            break;
+        }
+#endif
+    }
+
+    // the calling thread helps, then waits for chunks still running on workers
+    while (!done.try_wait()) {
+        if (!pool.run_pending_task()) {
+            done.wait();
+        }
+    }
+
+    if (error.failed()) {
+        error.rethrow();
+        return result_type(detail::error, std::move(error).take());
+    }
+    if constexpr (std::is_void_v<value_type>) {
+        return result_type();
+    }
+    else {
+        return result_type(std::in_place, std::move(values).take());
+    }
+}
+
+/// 'parallel_transform' on 'thread_pool::shared()'
+template <typename R, typename F>
+    requires (std::ranges::random_access_range<R> && std::ranges::sized_range<R>
+              && detail::is_result_v<detail::parallel_result_t<R, F>>)
+[[nodiscard]]
+inline auto parallel_transform(R&& range, F&& f, std::size_t chunk_size = 0) {
+    return parallel_transform(thread_pool::shared(), std::forward<R>(range), std::forward<F>(f), chunk_size);
+}
+}
+
+#endif //RESCPP_PARALLEL_H
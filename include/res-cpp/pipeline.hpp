@@ -0,0 +1,269 @@
+#ifndef RESCPP_PIPELINE_H
+#define RESCPP_PIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+#include "res-cpp.hpp"
+
+// Lazy pipeline of result combinators, composed once and run in a single pass.
+// Values and errors get handed from step to step directly,
+// no intermediate 'result' is built between the steps.
+//
+//   constexpr rescpp::pipeline parse_config(
+//       rescpp::and_then(parse_int),
+//       rescpp::transform([](int value) { return value * 2; }),
+//       rescpp::transform_error(to_config_error)
+//   );
+//   auto res = parse_config(read_file(path));
+//   // or
+//   auto res = read_file(path) | parse_config;
+
+namespace rescpp {
+namespace detail {
+template <typename F>
+struct and_then_step {
+    F f_;
+};
+
+template <typename F>
+struct transform_step {
+    F f_;
+};
+
+template <typename F>
+struct transform_error_step {
+    F f_;
+};
+
+template <typename F>
+struct or_else_step {
+    F f_;
+};
+
+/// value handed between the steps, 'void' values become 'void_result_value'
+template <typename V>
+using step_value_t = std::conditional_t<std::is_void_v<V>, void_result_value, V>;
+
+template <typename V, typename F, typename A>
+inline constexpr decltype(auto) call_with_value(const F& f, A&& value) {
+    if constexpr (std::is_void_v<V>) {
+        return std::invoke(f);
+    }
+    else {
+        return std::invoke(f, std::forward<A>(value));
+    }
+}
+
+template <typename V, typename F>
+using call_with_value_t = decltype(call_with_value<V>(std::declval<const F&>(), std::declval<step_value_t<V>>()));
+
+template <typename V>
+using normalize_value_t = std::conditional_t<std::is_reference_v<V>, V, std::remove_cv_t<V>>;
+
+/// value and error type after 'Step' was applied to a value 'V' or error 'E'
+template <typename Step, typename V, typename E>
+struct step_types;
+
+template <typename F, typename V, typename E>
+struct step_types<and_then_step<F>, V, E> {
+    using next_type = std::remove_cvref_t<call_with_value_t<V, F>>;
+    static_assert(is_result_v<next_type>, "function passed to 'and_then' has to return a result");
+
+    using value_type = typename next_type::value_type;
+    using error_type = typename next_type::error_type;
+};
+
+template <typename F, typename V, typename E>
+struct step_types<transform_step<F>, V, E> {
+    using value_type = normalize_value_t<call_with_value_t<V, F>>;
+    using error_type = E;
+};
+
+template <typename F, typename V, typename E>
+struct step_types<transform_error_step<F>, V, E> {
+    using value_type = V;
+    using error_type = std::remove_cvref_t<std::invoke_result_t<const F&, E&&>>;
+};
+
+template <typename F, typename V, typename E>
+struct step_types<or_else_step<F>, V, E> {
+    using next_type = std::remove_cvref_t<std::invoke_result_t<const F&, E&&>>;
+    static_assert(is_result_v<next_type>, "function passed to 'or_else' has to return a result");
+    static_assert(std::is_same_v<typename next_type::value_type, V>,
+                  "function passed to 'or_else' has to return a result with the same value type");
+
+    using value_type = V;
+    using error_type = typename next_type::error_type;
+};
+
+template <typename V, typename E, typename... Steps>
+struct pipeline_output {
+    using type = result<V, E>;
+};
+
+template <typename V, typename E, typename Step, typename... Rest>
+struct pipeline_output<V, E, Step, Rest...> {
+    using types = step_types<Step, V, E>;
+    using type = typename pipeline_output<typename types::value_type, typename types::error_type, Rest...>::type;
+};
+
+template <typename Step, template <typename> typename Kind>
+inline constexpr bool is_step_v = false;
+
+template <typename F, template <typename> typename Kind>
+inline constexpr bool is_step_v<Kind<F>, Kind> = true;
+
+/// hands an error on without a copy or move when the type does not change
+template <typename To, typename From>
+inline constexpr decltype(auto) forward_error(From&& error) {
+    if constexpr (std::is_same_v<std::remove_cvref_t<From>, To>) {
+        return std::forward<From>(error);
+    }
+    else {
+        return convert_error<To>(std::forward<From>(error));
+    }
+}
+}
+
+template <typename... Steps>
+class pipeline {
+    std::tuple<Steps...> steps_;
+
+    template <std::size_t I>
+    using step_t = std::tuple_element_t<I, std::tuple<Steps...>>;
+
+    template <std::size_t I, typename V, typename E, typename Out, typename Next>
+    inline constexpr Out branch(Next&& next) const {
+        using next_value = typename std::remove_cvref_t<Next>::value_type;
+        using next_error = typename std::remove_cvref_t<Next>::error_type;
+
+        if (next.has_error()) {
+            return run_error<I + 1, next_value, next_error, Out>(std::forward<Next>(next).error());
+        }
+        if constexpr (std::is_void_v<next_value>) {
+            return run_value<I + 1, next_value, next_error, Out>(detail::void_result_value{});
+        }
+        else {
+            return run_value<I + 1, next_value, next_error, Out>(std::forward<Next>(next).value());
+        }
+    }
+
+    template <std::size_t I, typename V, typename E, typename Out, typename A>
+    inline constexpr Out run_value(A&& value) const {
+        if constexpr (I == sizeof...(Steps)) {
+            if constexpr (std::is_void_v<V>) {
+                return Out();
+            }
+            else {
+                return Out(std::in_place, std::forward<A>(value));
+            }
+        }
+        else {
+            using step = step_t<I>;
+            using types = detail::step_types<step, V, E>;
+            using next_value = typename types::value_type;
+            using next_error = typename types::error_type;
+            const auto& f = std::get<I>(steps_).f_;
+
+            if constexpr (detail::is_step_v<step, detail::and_then_step>) {
+                return branch<I, V, E, Out>(detail::call_with_value<V>(f, std::forward<A>(value)));
+            }
+            else if constexpr (detail::is_step_v<step, detail::transform_step>) {
+                if constexpr (std::is_void_v<next_value>) {
+                    detail::call_with_value<V>(f, std::forward<A>(value));
+                    return run_value<I + 1, next_value, next_error, Out>(detail::void_result_value{});
+                }
+                else {
+                    return run_value<I + 1, next_value, next_error, Out>(detail::call_with_value<V>(f, std::forward<A>(value)));
+                }
+            }
+            else {
+                return run_value<I + 1, next_value, next_error, Out>(std::forward<A>(value));
+            }
+        }
+    }
+
+    template <std::size_t I, typename V, typename E, typename Out, typename A>
+    inline constexpr Out run_error(A&& error) const {
+        if constexpr (I == sizeof...(Steps)) {
+            return Out(detail::error, std::forward<A>(error));
+        }
+        else {
+            using step = step_t<I>;
+            using types = detail::step_types<step, V, E>;
+            using next_value = typename types::value_type;
+            using next_error = typename types::error_type;
+            const auto& f = std::get<I>(steps_).f_;
+
+            if constexpr (detail::is_step_v<step, detail::and_then_step>) {
+                return run_error<I + 1, next_value, next_error, Out>(detail::forward_error<next_error>(std::forward<A>(error)));
+            }
+            else if constexpr (detail::is_step_v<step, detail::transform_error_step>) {
+                return run_error<I + 1, next_value, next_error, Out>(std::invoke(f, std::forward<A>(error)));
+            }
+            else if constexpr (detail::is_step_v<step, detail::or_else_step>) {
+                return branch<I, V, E, Out>(std::invoke(f, std::forward<A>(error)));
+            }
+            else {
+                return run_error<I + 1, next_value, next_error, Out>(std::forward<A>(error));
+            }
+        }
+    }
+
+public:
+    explicit inline constexpr pipeline(Steps... steps)
+        : steps_(std::move(steps)...) {}
+
+    template <typename R>
+        requires (detail::is_result_v<std::remove_cvref_t<R>>)
+    inline constexpr auto operator()(R&& res) const {
+        using value_type = detail::result_value_t<R>;
+        using error_type = detail::result_error_t<R>;
+        using output_type = typename detail::pipeline_output<value_type, error_type, Steps...>::type;
+
+        if (res.has_error()) {
+            return run_error<0, value_type, error_type, output_type>(std::forward<R>(res).error());
+        }
+        if constexpr (std::is_void_v<value_type>) {
+            return run_value<0, value_type, error_type, output_type>(detail::void_result_value{});
+        }
+        else {
+            return run_value<0, value_type, error_type, output_type>(std::forward<R>(res).value());
+        }
+    }
+
+    template <typename R>
+        requires (detail::is_result_v<std::remove_cvref_t<R>>)
+    friend inline constexpr auto operator|(R&& res, const pipeline& pipe) {
+        return pipe(std::forward<R>(res));
+    }
+};
+
+template <typename... Steps>
+pipeline(Steps...) -> pipeline<Steps...>;
+
+template <typename F>
+inline constexpr detail::and_then_step<std::decay_t<F>> and_then(F&& f) {
+    return { std::forward<F>(f) };
+}
+
+template <typename F>
+inline constexpr detail::transform_step<std::decay_t<F>> transform(F&& f) {
+    return { std::forward<F>(f) };
+}
+
+template <typename F>
+inline constexpr detail::transform_error_step<std::decay_t<F>> transform_error(F&& f) {
+    return { std::forward<F>(f) };
+}
+
+template <typename F>
+inline constexpr detail::or_else_step<std::decay_t<F>> or_else(F&& f) {
+    return { std::forward<F>(f) };
+}
+}
+
+#endif //RESCPP_PIPELINE_H
@@ -0,0 +1,382 @@
+#ifndef RESCPP_PROFILER_H
+#define RESCPP_PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "stats.hpp"
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define RESCPP_PROFILER_EXECINFO
+#elif __has_include(<stacktrace>)
+#include <stacktrace>
+#endif
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define RESCPP_PROFILER_DLADDR
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define RESCPP_PROFILER_DEMANGLE
+#endif
+
+// Sampling error profiler, enabled with 'RESCPP_ENABLE_PROFILER'.
+// Every error created with 'fail(...)' decrements a thread local counter, once it reaches zero
+// the stack of the error gets captured (one out of 'sample_interval()' errors).
+// Captured stacks go into a lock free buffer, a background thread started with 'start()'
+// folds them into stacks in the collapsed format of flamegraph.pl ('main;load;parse;[parse_error] 12').
+// Stacks are captured with 'backtrace' (execinfo) or '<stacktrace>', frames get named through 'dladdr',
+// functions of the executable only have names if it exports its symbols ('-rdynamic', cmake 'ENABLE_EXPORTS').
+// Without 'RESCPP_ENABLE_PROFILER' nothing gets sampled and 'fail' is unchanged.
+//
+//   rescpp::profiler::set_sample_interval(100);
+//   rescpp::profiler::start();
+//   ...
+//   rescpp::profiler::stop();
+//   rescpp::profiler::write_folded("errors.folded");
+//   // flamegraph.pl errors.folded > errors.svg
+
+#ifndef RESCPP_PROFILER_SAMPLE_INTERVAL
+#define RESCPP_PROFILER_SAMPLE_INTERVAL 1024
+#endif
+
+#ifndef RESCPP_PROFILER_DEPTH
+#define RESCPP_PROFILER_DEPTH 32
+#endif
+
+#ifndef RESCPP_PROFILER_CAPACITY
+#define RESCPP_PROFILER_CAPACITY 256
+#endif
+
+namespace rescpp {
+namespace profiler {
+#if defined(RESCPP_ENABLE_PROFILER)
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+/// frames kept per sample
+inline constexpr std::size_t depth = RESCPP_PROFILER_DEPTH;
+
+/// samples the buffer holds until the background thread folds them
+inline constexpr std::size_t capacity = RESCPP_PROFILER_CAPACITY;
+
+static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "'RESCPP_PROFILER_CAPACITY' has to be a power of two");
+static_assert(RESCPP_PROFILER_SAMPLE_INTERVAL > 0, "'RESCPP_PROFILER_SAMPLE_INTERVAL' has to be at least 1");
+}
+
+namespace detail {
+/// errors left until the next sample of this thread, trivially initialized so no guard gets checked
+inline thread_local std::uint32_t profiler_countdown = RESCPP_PROFILER_SAMPLE_INTERVAL;
+
+struct profiler_record {
+    const std::string_view* type;
+    std::uint32_t frame_count;
+    void* frames[profiler::depth];
+};
+
+// position the slot is ready for: 'position' to be written, 'position + 1' to be read
+struct profiler_slot {
+    std::atomic<std::size_t> sequence;
+    profiler_record sample;
+};
+
+class profiler_state {
+    profiler_slot slots_[profiler::capacity];
+    std::atomic<std::size_t> tail_ = 0;
+    // guarded by 'fold_mutex_'
+    std::size_t head_ = 0;
+
+    std::atomic<std::uint64_t> dropped_ = 0;
+
+    std::mutex fold_mutex_;
+    std::map<std::string, std::uint64_t> stacks_;
+    std::uint64_t samples_ = 0;
+    std::unordered_map<void*, std::string> frame_names_;
+
+    std::mutex thread_mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+    bool stopping_ = false;
+
+    [[nodiscard]]
+    static inline std::string frame_name(void* address) {
+#if defined(RESCPP_PROFILER_DLADDR)
+        Dl_info info;
+        if (dladdr(address, &info) != 0) {
+            if (info.dli_sname != nullptr) {
+#if defined(RESCPP_PROFILER_DEMANGLE)
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                if (demangled != nullptr) {
+                    std::string name(demangled);
+                    std::free(demangled);
+                    return name;
+                }
+#endif
+                return info.dli_sname;
+            }
+            if (info.dli_fname != nullptr) {
+                const std::string_view module(info.dli_fname);
+                char offset[32];
+                std::snprintf(offset, sizeof(offset), "+0x%zx",
+                              static_cast<std::size_t>(static_cast<const char*>(address) - static_cast<const char*>(info.dli_fbase)));
+                return std::string(module.substr(module.find_last_of('/') + 1)) + offset;
+            }
+        }
+#endif
+        char name[32];
+        std::snprintf(name, sizeof(name), "%p", address);
+        return name;
+    }
+
+    // called with 'fold_mutex_' held
+    inline void fold(const profiler_record& sample) {
+        std::string stack;
+        for (std::uint32_t i = sample.frame_count; i > 0; --i) {
+            void* address = sample.frames[i - 1];
+            auto name = frame_names_.find(address);
+            if (name == frame_names_.end()) {
+                name = frame_names_.emplace(address, frame_name(address)).first;
+            }
+            stack += name->second;
+            stack += ';';
+        }
+        stack += '[';
+        stack += *sample.type;
+        stack += ']';
+        ++stacks_[stack];
+        ++samples_;
+    }
+
+    inline void run() {
+        std::unique_lock lock(thread_mutex_);
+        while (!stopping_) {
+            wake_.wait_for(lock, std::chrono::milliseconds(10));
+            drain();
+        }
+    }
+
+public:
+    std::atomic<bool> running = false;
+    std::atomic<std::uint32_t> interval = RESCPP_PROFILER_SAMPLE_INTERVAL;
+
+    inline profiler_state() {
+        for (std::size_t i = 0; i < profiler::capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    inline ~profiler_state() {
+        stop();
+    }
+
+    /// drops the sample if the buffer is full
+    inline void push(const std::string_view* type, void* const* frames, std::uint32_t frame_count) noexcept {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            profiler_slot& slot = slots_[pos & (profiler::capacity - 1)];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.sample.type = type;
+                    slot.sample.frame_count = frame_count;
+                    for (std::uint32_t i = 0; i < frame_count; ++i) {
+                        slot.sample.frames[i] = frames[i];
+                    }
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            }
+            else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// folds every sample in the buffer
+    inline void drain() {
+        std::lock_guard lock(fold_mutex_);
+        while (true) {
+            profiler_slot& slot = slots_[head_ & (profiler::capacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+                return;
+            }
+            fold(slot.sample);
+            slot.sequence.store(head_ + profiler::capacity, std::memory_order_release);
+            ++head_;
+        }
+    }
+
+    inline bool start() {
+        std::lock_guard lock(thread_mutex_);
+        if (thread_.joinable()) {
+            return false;
+        }
+        stopping_ = false;
+        thread_ = std::thread([this] { run(); });
+        running.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    inline void stop() {
+        running.store(false, std::memory_order_relaxed);
+        std::thread thread;
+        {
+            std::lock_guard lock(thread_mutex_);
+            stopping_ = true;
+            thread = std::move(thread_);
+        }
+        wake_.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+        drain();
+    }
+
+    inline void clear() {
+        std::lock_guard lock(fold_mutex_);
+        stacks_.clear();
+        samples_ = 0;
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    inline std::uint64_t samples() {
+        std::lock_guard lock(fold_mutex_);
+        return samples_;
+    }
+
+    [[nodiscard]]
+    inline std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    inline bool write_folded(std::FILE* file) {
+        std::lock_guard lock(fold_mutex_);
+        for (const auto& [stack, count] : stacks_) {
+            std::fprintf(file, "%s %llu\n", stack.c_str(), static_cast<unsigned long long>(count));
+        }
+        return std::ferror(file) == 0;
+    }
+};
+
+[[nodiscard]]
+inline profiler_state& profiler_instance() {
+    static profiler_state state;
+    return state;
+}
+
+/// slow path of a sampled error, kept out of 'fail'
+template <typename E>
+[[gnu::noinline, gnu::cold]]
+inline void profiler_capture() noexcept {
+    profiler_state& state = profiler_instance();
+    profiler_countdown = std::max<std::uint32_t>(state.interval.load(std::memory_order_relaxed), 1);
+    if (!state.running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    void* frames[profiler::depth + 1];
+    std::uint32_t frame_count = 0;
+#if defined(RESCPP_PROFILER_EXECINFO)
+    frame_count = static_cast<std::uint32_t>(backtrace(frames, static_cast<int>(profiler::depth + 1)));
+#elif defined(__cpp_lib_stacktrace)
+    for (const auto& entry : std::stacktrace::current(0, profiler::depth + 1)) {
+        frames[frame_count++] = reinterpret_cast<void*>(entry.native_handle());
+    }
+#endif
+    // the first frame is this function
+    const std::uint32_t skipped = frame_count > 0 ? 1 : 0;
+    state.push(&stats_type<E>::name, frames + skipped, frame_count - skipped);
+}
+}
+
+namespace profiler {
+/// Counts an error of type 'E', captures its stack once the countdown of this thread reaches zero.
+template <typename E>
+inline void sample() noexcept {
+    if (--detail::profiler_countdown == 0) [[unlikely]] {
+        detail::profiler_capture<E>();
+    }
+}
+
+/// One out of 'interval' errors gets sampled.
+/// Applies to the calling thread right away, to other threads after their next sample.
+inline void set_sample_interval(std::uint32_t interval) noexcept {
+    interval = std::max<std::uint32_t>(interval, 1);
+    detail::profiler_instance().interval.store(interval, std::memory_order_relaxed);
+    detail::profiler_countdown = interval;
+}
+
+[[nodiscard]]
+inline std::uint32_t sample_interval() noexcept {
+    return detail::profiler_instance().interval.load(std::memory_order_relaxed);
+}
+
+/// Starts sampling and the background thread folding the samples, returns false if already started.
+inline bool start() {
+    return detail::profiler_instance().start();
+}
+
+/// Stops sampling, folds the remaining samples.
+inline void stop() {
+    detail::profiler_instance().stop();
+}
+
+/// Drops every folded stack.
+inline void clear() {
+    detail::profiler_instance().clear();
+}
+
+/// samples folded so far
+[[nodiscard]]
+inline std::uint64_t samples() {
+    return detail::profiler_instance().samples();
+}
+
+/// samples dropped since the buffer was full
+[[nodiscard]]
+inline std::uint64_t dropped() noexcept {
+    return detail::profiler_instance().dropped();
+}
+
+/// Folded stacks, one per line, root first with the error type as last frame: 'main;load;parse;[parse_error] 12'
+inline bool write_folded(std::FILE* file) {
+    return detail::profiler_instance().write_folded(file);
+}
+
+/// returns false if the file could not be written
+inline bool write_folded(const char* path) {
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool written = write_folded(file);
+    return std::fclose(file) == 0 && written;
+}
+}
+}
+
+#endif //RESCPP_PROFILER_H
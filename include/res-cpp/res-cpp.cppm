@@ -0,0 +1,98 @@
+module;
+
+// 'rescpp' named module, exports every header of the library.
+// The headers get compiled once when building the module, 'import rescpp;' only loads the compiled declarations.
+// Options ('RESCPP_DISABLE_CHECKS', ...) have to be defined when compiling this unit,
+// the cmake target 'res-cpp_module' takes them from 'res-cpp'.
+//
+// Macros can not be exported from a module, the try macros need '#include <res-cpp/res-cpp.hpp>'.
+// Without them errors get propagated with 'co_await' (needs '#include <coroutine>') or the combinators.
+//
+//   #include <coroutine>
+//   import rescpp;
+//
+//   rescpp::result<config, parse_error> load_config() {
+//       auto text = co_await read_file("config");
+//       co_return parse(text);
+//   }
+
+// standard headers stay in the global module fragment, only the library gets exported
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#elif __has_include(<stacktrace>)
+#include <stacktrace>
+#endif
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+export module rescpp;
+
+// attached to the global module, a program may include the headers and import the module at the same time
+export extern "C++" {
+#include "res-cpp.hpp"
+#include "any_error.hpp"
+#include "arena.hpp"
+#include "batch.hpp"
+#include "channel.hpp"
+#include "code.hpp"
+#include "collect.hpp"
+#include "coroutine.hpp"
+#include "enum_map.hpp"
+#include "exception.hpp"
+#include "parallel.hpp"
+#include "pipeline.hpp"
+#include "profiler.hpp"
+#include "result_vector.hpp"
+#include "sender.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+}
@@ -1,10 +1,45 @@
 #ifndef RESCPP_H
 #define RESCPP_H
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
-#include <optional>
 #include <type_traits>
 #include <memory>
+#include <functional>
+#include <string_view>
+
+// before the optional headers, 'stats.hpp' uses it
+namespace rescpp {
+namespace detail {
+/// name of 'E' from the signature of this function (gcc and clang), "unknown" otherwise
+template <typename E>
+[[nodiscard]]
+inline constexpr std::string_view type_name() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    constexpr std::size_t start = signature.find("E = ");
+    if constexpr (start != std::string_view::npos) {
+        constexpr std::size_t end = signature.find_first_of(";]", start);
+        return signature.substr(start + 4, end - start - 4);
+    }
+#endif
+    return "unknown";
+}
+}
+}
+
+#if defined(RESCPP_ENABLE_TRACE)
+#include "trace.hpp"
+#endif
+
+#if defined(RESCPP_ENABLE_STATS)
+#include "stats.hpp"
+#endif
+
+#if defined(RESCPP_ENABLE_PROFILER)
+#include "profiler.hpp"
+#endif
 
 namespace rescpp {
 namespace detail {
@@ -28,12 +63,68 @@ using make_lvalue_reference_t = std::remove_reference_t<T>&;
 template <typename From, typename To>
 struct type_converter;
 
+/// Opt-in description of a spare ("niche") representation of 'T',
+/// a value which never occurs as a real value of 'T'.
+/// Specializations provide:
+/// - 'static constexpr T niche() noexcept' returning the spare value
+/// - 'static constexpr bool is_niche(const T&) noexcept'
+template <typename T>
+struct niche_traits;
+
+/// Helper for specializing 'niche_traits' with a single sentinel value.
+/// e.g. 'template <> struct rescpp::niche_traits<my_enum> : rescpp::sentinel_niche<my_enum, my_enum::none> {};'
+template <typename T, T Sentinel>
+struct sentinel_niche {
+    [[nodiscard]]
+    static inline constexpr T niche() noexcept {
+        return Sentinel;
+    }
+
+    [[nodiscard]]
+    static inline constexpr bool is_niche(const T& value) noexcept {
+        return value == Sentinel;
+    }
+};
+
 namespace detail {
 template <typename From, typename To>
 concept has_type_converter = requires(const From& from) {
     { type_converter<From, To>::convert(from) } noexcept -> std::same_as<To>;
 };
 
+template <typename T>
+concept has_niche = requires(const T& value) {
+    { niche_traits<T>::niche() } noexcept -> std::same_as<T>;
+    { niche_traits<T>::is_niche(value) } noexcept -> std::same_as<bool>;
+};
+
+/// types without any state, every instance is interchangeable
+template <typename T>
+concept is_stateless = std::is_empty_v<T>
+    && std::is_trivially_default_constructible_v<T>
+    && std::is_trivially_copyable_v<T>;
+
+/// 'T' followed by a byte, which lands in the tail padding of 'T' if the compiler can reuse it
+template <typename T>
+struct tail_padding_probe {
+    [[no_unique_address]] T value;
+    unsigned char flag;
+};
+
+/// 'S' has tail padding the flag of a result can be kept in, the error fits in front of it.
+/// Only types which are not POD for the purpose of layout (e.g. a struct with a constructor) qualify,
+/// the compiler leaves their tail padding alone on assignment.
+/// An aggregate like '{ std::int64_t; std::int32_t; }' gets copied with its padding, which would overwrite the flag.
+/// Both sides have to be nothrow move constructible, so a failed state change never leaves a stale flag.
+template <typename S, typename E>
+concept has_tail_padding = std::is_class_v<S>
+    && sizeof(tail_padding_probe<S>) == sizeof(S)
+    && std::is_standard_layout_v<tail_padding_probe<S>>
+    && sizeof(E) <= offsetof(tail_padding_probe<S>, flag)
+    && alignof(E) <= alignof(S)
+    && std::is_nothrow_move_constructible_v<S>
+    && std::is_nothrow_move_constructible_v<E>;
+
 struct error_tag {};
 
 inline constexpr error_tag error{};
@@ -63,6 +154,10 @@ struct bad_result_access_exception final : std::logic_error {
 #define RESCPP_CHECKS_NOEXCEPT
 #endif
 
+// The bad access handlers are cold and never inlined,
+// so the checks in '.value()' and '.error()' only leave a compare and a call in the caller.
+
+[[noreturn, gnu::cold, gnu::noinline]]
 inline void throw_bad_error_access_exception() RESCPP_NOEXCEPT {
     const char* bad_error_access_exception_message = "cannot access error on a good result";
 #if defined(RESCPP_DISABLE_EXCEPTIONS)
@@ -76,6 +171,7 @@ inline void throw_bad_error_access_exception() RESCPP_NOEXCEPT {
 #endif
 }
 
+[[noreturn, gnu::cold, gnu::noinline]]
 inline void throw_bad_value_access_exception() RESCPP_NOEXCEPT {
     const char* bad_value_access_exception_message = "cannot access value on a bad result";
 #if defined(RESCPP_DISABLE_EXCEPTIONS)
@@ -92,57 +188,912 @@ inline void throw_bad_value_access_exception() RESCPP_NOEXCEPT {
 template <typename>
 struct reference_wrapper;
 
-template <typename T>
-struct reference_wrapper<T&> {
-private:
-    T* ptr;
+template <typename T>
+struct reference_wrapper<T&> {
+private:
+    T* ptr;
+
+    friend struct niche_traits<reference_wrapper>;
+
+    explicit inline constexpr reference_wrapper(std::nullptr_t) noexcept
+        : ptr(nullptr) {}
+
+public:
+    inline constexpr reference_wrapper(T& ref) noexcept
+        : ptr(std::addressof(ref)) {}
+
+    inline constexpr ~reference_wrapper() noexcept = default;
+
+    inline constexpr T& get() const noexcept {
+        return *ptr;
+    }
+
+    inline constexpr T* operator->() const noexcept {
+        return ptr;
+    }
+
+    inline constexpr T& operator*() const noexcept {
+        return *ptr;
+    }
+};
+
+template <typename T>
+struct reference_wrapper<const T&> {
+private:
+    const T* ptr;
+
+    friend struct niche_traits<reference_wrapper>;
+
+    explicit inline constexpr reference_wrapper(std::nullptr_t) noexcept
+        : ptr(nullptr) {}
+
+public:
+    inline constexpr reference_wrapper(const T& ref) noexcept
+        : ptr(std::addressof(ref)) {}
+
+    inline constexpr ~reference_wrapper() noexcept = default;
+
+    inline constexpr const T& get() const noexcept {
+        return *ptr;
+    }
+
+    inline constexpr const T* operator->() const noexcept {
+        return ptr;
+    }
+
+    inline constexpr operator const T&() const noexcept {
+        return *ptr;
+    }
+};
+
+/// stored value of 'result<void, E>'
+struct void_result_value {};
+
+/// Replaces the alive 'Old' object with a 'New' object constructed from 'args'.
+/// If constructing 'New' throws, 'old' is left untouched (strong guarantee),
+/// which needs either 'New' or 'Old' to be nothrow move constructible.
+template <typename New, typename Old, typename... Args>
+inline constexpr void reinit(New* new_ptr, Old* old_ptr, Args&&... args)
+    noexcept(std::is_nothrow_constructible_v<New, Args...>) {
+    if constexpr (std::is_nothrow_constructible_v<New, Args...>) {
+        std::destroy_at(old_ptr);
+        std::construct_at(new_ptr, std::forward<Args>(args)...);
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<New>) {
+        New temp(std::forward<Args>(args)...);
+        std::destroy_at(old_ptr);
+        std::construct_at(new_ptr, std::move(temp));
+    }
+    else {
+        static_assert(std::is_nothrow_move_constructible_v<Old>,
+                      "either the new or the old type has to be nothrow move constructible");
+        Old temp(std::move(*old_ptr));
+        std::destroy_at(old_ptr);
+#if defined(__cpp_exceptions)
+        try {
+            std::construct_at(new_ptr, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            std::construct_at(old_ptr, std::move(temp));
+            throw;
+        }
+#else
+        std::construct_at(new_ptr, std::forward<Args>(args)...);
+#endif
+    }
+}
+
+/// Replaces the alive 'T' with one constructed from 'args'.
+/// Strong guarantee when 'T' is nothrow constructible from 'args' or nothrow move constructible,
+/// otherwise the new object gets move assigned and the guarantee is the one of that assignment.
+template <typename T, typename... Args>
+inline constexpr void reconstruct(T* ptr, Args&&... args)
+    noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+        std::destroy_at(ptr);
+        std::construct_at(ptr, std::forward<Args>(args)...);
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        T temp(std::forward<Args>(args)...);
+        std::destroy_at(ptr);
+        std::construct_at(ptr, std::move(temp));
+    }
+    else {
+        *ptr = T(std::forward<Args>(args)...);
+    }
+}
+
+/// Converts to what 'f' returns, passed to a storage the member gets initialized by 'f' directly.
+template <typename F>
+struct construct_from {
+    F f_;
+
+    inline constexpr operator std::invoke_result_t<F&>() && {
+        return f_();
+    }
+};
+
+template <typename F>
+construct_from(F) -> construct_from<F>;
+
+/// Constructs a 'T' from 'args' with uses allocator construction and 'alloc'.
+template <typename T, typename Alloc, typename... Args>
+inline constexpr auto construct_using_allocator(const Alloc& alloc, Args&&... args) noexcept {
+    return construct_from{ [&]() -> T {
+        return std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...);
+    } };
+}
+
+/// result and error share the storage, 'has_error_' tells which one is alive
+template <typename S, typename E>
+struct tagged_storage {
+    union {
+        E error_;
+        S value_;
+    };
+
+    bool has_error_;
+
+    template <typename... Args>
+    explicit inline constexpr tagged_storage(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>)
+        : value_(std::forward<Args>(args)...), has_error_(false) {}
+
+    template <typename... Args>
+    explicit inline constexpr tagged_storage(error_tag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>)
+        : error_(std::forward<Args>(args)...), has_error_(true) {}
+
+    // trivial special members keep results of trivial types trivially copyable,
+    // which lets them get passed and returned in registers
+
+    inline constexpr tagged_storage(const tagged_storage&)
+        requires (std::is_trivially_copy_constructible_v<S>
+            && std::is_trivially_copy_constructible_v<E>) = default;
+
+    inline constexpr tagged_storage(const tagged_storage& other)
+        noexcept(std::is_nothrow_copy_constructible_v<S>
+            && std::is_nothrow_copy_constructible_v<E>)
+        requires (std::is_copy_constructible_v<S>
+            && std::is_copy_constructible_v<E>
+            && !(std::is_trivially_copy_constructible_v<S>
+                && std::is_trivially_copy_constructible_v<E>))
+        : has_error_(other.has_error_) {
+        if (has_error_) {
+            std::construct_at(std::addressof(error_), other.error_);
+        }
+        else {
+            std::construct_at(std::addressof(value_), other.value_);
+        }
+    }
+
+    inline constexpr tagged_storage(tagged_storage&&)
+        requires (std::is_trivially_move_constructible_v<S>
+            && std::is_trivially_move_constructible_v<E>) = default;
+
+    inline constexpr tagged_storage(tagged_storage&& other)
+        noexcept(std::is_nothrow_move_constructible_v<S>
+            && std::is_nothrow_move_constructible_v<E>)
+        requires (std::is_move_constructible_v<S>
+            && std::is_move_constructible_v<E>
+            && !(std::is_trivially_move_constructible_v<S>
+                && std::is_trivially_move_constructible_v<E>))
+        : has_error_(other.has_error_) {
+        if (has_error_) {
+            std::construct_at(std::addressof(error_), std::move(other.error_));
+        }
+        else {
+            std::construct_at(std::addressof(value_), std::move(other.value_));
+        }
+    }
+
+    inline constexpr tagged_storage& operator=(const tagged_storage&)
+        requires (std::is_trivially_copy_assignable_v<S>
+            && std::is_trivially_copy_assignable_v<E>
+            && std::is_trivially_copy_constructible_v<S>
+            && std::is_trivially_copy_constructible_v<E>
+            && std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    /// Same state assigns in place (existing buffers get reused),
+    /// otherwise the alive object gets replaced through 'reinit'.
+    inline constexpr tagged_storage& operator=(const tagged_storage& other)
+        noexcept(std::is_nothrow_copy_constructible_v<S>
+            && std::is_nothrow_copy_constructible_v<E>
+            && std::is_nothrow_copy_assignable_v<S>
+            && std::is_nothrow_copy_assignable_v<E>)
+        requires (std::is_copy_constructible_v<S>
+            && std::is_copy_constructible_v<E>
+            && std::is_copy_assignable_v<S>
+            && std::is_copy_assignable_v<E>
+            && (std::is_nothrow_move_constructible_v<S>
+                || std::is_nothrow_move_constructible_v<E>)
+            && !(std::is_trivially_copy_assignable_v<S>
+                && std::is_trivially_copy_assignable_v<E>
+                && std::is_trivially_copy_constructible_v<S>
+                && std::is_trivially_copy_constructible_v<E>
+                && std::is_trivially_destructible_v<S>
+                && std::is_trivially_destructible_v<E>)) {
+        if (has_error_ && other.has_error_) {
+            error_ = other.error_;
+        }
+        else if (!has_error_ && !other.has_error_) {
+            value_ = other.value_;
+        }
+        else if (other.has_error_) {
+            reinit(std::addressof(error_), std::addressof(value_), other.error_);
+            has_error_ = true;
+        }
+        else {
+            reinit(std::addressof(value_), std::addressof(error_), other.value_);
+            has_error_ = false;
+        }
+        return *this;
+    }
+
+    inline constexpr tagged_storage& operator=(tagged_storage&&)
+        requires (std::is_trivially_move_assignable_v<S>
+            && std::is_trivially_move_assignable_v<E>
+            && std::is_trivially_move_constructible_v<S>
+            && std::is_trivially_move_constructible_v<E>
+            && std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    inline constexpr tagged_storage& operator=(tagged_storage&& other)
+        noexcept(std::is_nothrow_move_constructible_v<S>
+            && std::is_nothrow_move_constructible_v<E>
+            && std::is_nothrow_move_assignable_v<S>
+            && std::is_nothrow_move_assignable_v<E>)
+        requires (std::is_move_constructible_v<S>
+            && std::is_move_constructible_v<E>
+            && std::is_move_assignable_v<S>
+            && std::is_move_assignable_v<E>
+            && (std::is_nothrow_move_constructible_v<S>
+                || std::is_nothrow_move_constructible_v<E>)
+            && !(std::is_trivially_move_assignable_v<S>
+                && std::is_trivially_move_assignable_v<E>
+                && std::is_trivially_move_constructible_v<S>
+                && std::is_trivially_move_constructible_v<E>
+                && std::is_trivially_destructible_v<S>
+                && std::is_trivially_destructible_v<E>)) {
+        if (has_error_ && other.has_error_) {
+            error_ = std::move(other.error_);
+        }
+        else if (!has_error_ && !other.has_error_) {
+            value_ = std::move(other.value_);
+        }
+        else if (other.has_error_) {
+            reinit(std::addressof(error_), std::addressof(value_), std::move(other.error_));
+            has_error_ = true;
+        }
+        else {
+            reinit(std::addressof(value_), std::addressof(error_), std::move(other.value_));
+            has_error_ = false;
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    inline constexpr S& emplace_value(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>) {
+        if (has_error_) {
+            reinit(std::addressof(value_), std::addressof(error_), std::forward<Args>(args)...);
+            has_error_ = false;
+        }
+        else {
+            reconstruct(std::addressof(value_), std::forward<Args>(args)...);
+        }
+        return value_;
+    }
+
+    template <typename... Args>
+    inline constexpr E& emplace_error(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>) {
+        if (has_error_) {
+            reconstruct(std::addressof(error_), std::forward<Args>(args)...);
+        }
+        else {
+            reinit(std::addressof(error_), std::addressof(value_), std::forward<Args>(args)...);
+            has_error_ = true;
+        }
+        return error_;
+    }
+
+    inline constexpr ~tagged_storage() noexcept
+        requires (std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    inline constexpr ~tagged_storage() noexcept {
+        if (has_error_) {
+            if constexpr (!std::is_trivially_destructible_v<E>) {
+                std::destroy_at(std::addressof(error_));
+            }
+            return;
+        }
+
+        if constexpr (!std::is_trivially_destructible_v<S>) {
+            std::destroy_at(std::addressof(value_));
+        }
+    }
+
+    [[nodiscard]]
+    inline constexpr bool has_error() const noexcept {
+        return has_error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr S& value() noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const S& value() const noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr E& error() noexcept {
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const E& error() const noexcept {
+        return error_;
+    }
+};
+
+/// Like 'tagged_storage', but the flag is kept in the tail padding of 'S' (see 'has_tail_padding'),
+/// so the result is as big as 'S'. The flag gets accessed through the bytes of the storage,
+/// which can't be done in constant expressions.
+template <typename S, typename E>
+struct tail_padding_storage {
+    static inline constexpr std::size_t flag_offset = offsetof(tail_padding_probe<S>, flag);
+
+    union {
+        E error_;
+        // potentially overlapping, assigning the value leaves the flag behind it alone
+        [[no_unique_address]] S value_;
+    };
+
+    template <typename... Args>
+    explicit inline tail_padding_storage(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>)
+        : value_(std::forward<Args>(args)...) {
+        set_has_error(false);
+    }
+
+    template <typename... Args>
+    explicit inline tail_padding_storage(error_tag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>)
+        : error_(std::forward<Args>(args)...) {
+        set_has_error(true);
+    }
+
+    // trivial special members copy the flag with the bytes of the union
+
+    inline constexpr tail_padding_storage(const tail_padding_storage&)
+        requires (std::is_trivially_copy_constructible_v<S>
+            && std::is_trivially_copy_constructible_v<E>) = default;
+
+    inline tail_padding_storage(const tail_padding_storage& other)
+        noexcept(std::is_nothrow_copy_constructible_v<S>
+            && std::is_nothrow_copy_constructible_v<E>)
+        requires (std::is_copy_constructible_v<S>
+            && std::is_copy_constructible_v<E>
+            && !(std::is_trivially_copy_constructible_v<S>
+                && std::is_trivially_copy_constructible_v<E>)) {
+        if (other.has_error()) {
+            std::construct_at(std::addressof(error_), other.error_);
+            set_has_error(true);
+        }
+        else {
+            std::construct_at(std::addressof(value_), other.value_);
+            set_has_error(false);
+        }
+    }
+
+    inline constexpr tail_padding_storage(tail_padding_storage&&)
+        requires (std::is_trivially_move_constructible_v<S>
+            && std::is_trivially_move_constructible_v<E>) = default;
+
+    inline tail_padding_storage(tail_padding_storage&& other) noexcept
+        requires (!(std::is_trivially_move_constructible_v<S>
+            && std::is_trivially_move_constructible_v<E>)) {
+        if (other.has_error()) {
+            std::construct_at(std::addressof(error_), std::move(other.error_));
+            set_has_error(true);
+        }
+        else {
+            std::construct_at(std::addressof(value_), std::move(other.value_));
+            set_has_error(false);
+        }
+    }
+
+    inline constexpr tail_padding_storage& operator=(const tail_padding_storage&)
+        requires (std::is_trivially_copy_assignable_v<S>
+            && std::is_trivially_copy_assignable_v<E>
+            && std::is_trivially_copy_constructible_v<S>
+            && std::is_trivially_copy_constructible_v<E>
+            && std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    /// Same state assigns in place (existing buffers get reused), otherwise the alive object gets replaced.
+    inline tail_padding_storage& operator=(const tail_padding_storage& other)
+        noexcept(std::is_nothrow_copy_constructible_v<S>
+            && std::is_nothrow_copy_constructible_v<E>
+            && std::is_nothrow_copy_assignable_v<S>
+            && std::is_nothrow_copy_assignable_v<E>)
+        requires (std::is_copy_constructible_v<S>
+            && std::is_copy_constructible_v<E>
+            && std::is_copy_assignable_v<S>
+            && std::is_copy_assignable_v<E>
+            && !(std::is_trivially_copy_assignable_v<S>
+                && std::is_trivially_copy_assignable_v<E>
+                && std::is_trivially_copy_constructible_v<S>
+                && std::is_trivially_copy_constructible_v<E>
+                && std::is_trivially_destructible_v<S>
+                && std::is_trivially_destructible_v<E>)) {
+        if (has_error() && other.has_error()) {
+            error_ = other.error_;
+        }
+        else if (!has_error() && !other.has_error()) {
+            value_ = other.value_;
+        }
+        else if (other.has_error()) {
+            emplace_error(other.error_);
+        }
+        else {
+            emplace_value(other.value_);
+        }
+        return *this;
+    }
+
+    inline constexpr tail_padding_storage& operator=(tail_padding_storage&&)
+        requires (std::is_trivially_move_assignable_v<S>
+            && std::is_trivially_move_assignable_v<E>
+            && std::is_trivially_move_constructible_v<S>
+            && std::is_trivially_move_constructible_v<E>
+            && std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    inline tail_padding_storage& operator=(tail_padding_storage&& other)
+        noexcept(std::is_nothrow_move_assignable_v<S>
+            && std::is_nothrow_move_assignable_v<E>)
+        requires (std::is_move_assignable_v<S>
+            && std::is_move_assignable_v<E>
+            && !(std::is_trivially_move_assignable_v<S>
+                && std::is_trivially_move_assignable_v<E>
+                && std::is_trivially_move_constructible_v<S>
+                && std::is_trivially_move_constructible_v<E>
+                && std::is_trivially_destructible_v<S>
+                && std::is_trivially_destructible_v<E>)) {
+        if (has_error() && other.has_error()) {
+            error_ = std::move(other.error_);
+        }
+        else if (!has_error() && !other.has_error()) {
+            value_ = std::move(other.value_);
+        }
+        else if (other.has_error()) {
+            emplace_error(std::move(other.error_));
+        }
+        else {
+            emplace_value(std::move(other.value_));
+        }
+        return *this;
+    }
+
+    inline constexpr ~tail_padding_storage() noexcept
+        requires (std::is_trivially_destructible_v<S>
+            && std::is_trivially_destructible_v<E>) = default;
+
+    inline ~tail_padding_storage() noexcept {
+        if (has_error()) {
+            std::destroy_at(std::addressof(error_));
+        }
+        else {
+            std::destroy_at(std::addressof(value_));
+        }
+    }
+
+    template <typename... Args>
+    inline S& emplace_value(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>) {
+        // constructing a complete 'S' may write its padding, the flag gets written afterward
+        if (has_error()) {
+            reinit(std::addressof(value_), std::addressof(error_), std::forward<Args>(args)...);
+        }
+        else {
+            reconstruct(std::addressof(value_), std::forward<Args>(args)...);
+        }
+        set_has_error(false);
+        return value_;
+    }
+
+    template <typename... Args>
+    inline E& emplace_error(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>) {
+        if (has_error()) {
+            reconstruct(std::addressof(error_), std::forward<Args>(args)...);
+        }
+        else {
+            reinit(std::addressof(error_), std::addressof(value_), std::forward<Args>(args)...);
+        }
+        set_has_error(true);
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline bool has_error() const noexcept {
+        return *(reinterpret_cast<const unsigned char*>(this) + flag_offset) != 0;
+    }
+
+    [[nodiscard]]
+    inline constexpr S& value() noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const S& value() const noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr E& error() noexcept {
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const E& error() const noexcept {
+        return error_;
+    }
+
+private:
+    inline void set_has_error(bool has_error) noexcept {
+        *(reinterpret_cast<unsigned char*>(this) + flag_offset) = has_error ? 1 : 0;
+    }
+};
+
+/// the niche of 'S' marks the error state, 'E' is stateless so nothing else has to be stored
+template <typename S, typename E>
+struct value_niche_storage {
+    // not const so the error can be moved from, 'E' has no state to modify
+    static inline E error_{};
+
+    S value_;
+
+    template <typename... Args>
+    explicit inline constexpr value_niche_storage(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>)
+        : value_(std::forward<Args>(args)...) {}
+
+    template <typename... Args>
+    explicit inline constexpr value_niche_storage(error_tag, Args&&...) noexcept
+        : value_(niche_traits<S>::niche()) {}
+
+    template <typename... Args>
+    inline constexpr S& emplace_value(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<S, Args...>) {
+        reconstruct(std::addressof(value_), std::forward<Args>(args)...);
+        return value_;
+    }
+
+    template <typename... Args>
+    inline constexpr E& emplace_error(Args&&...) noexcept {
+        reconstruct(std::addressof(value_), niche_traits<S>::niche());
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr bool has_error() const noexcept {
+        return niche_traits<S>::is_niche(value_);
+    }
+
+    [[nodiscard]]
+    inline constexpr S& value() noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const S& value() const noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr E& error() noexcept {
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const E& error() const noexcept {
+        return error_;
+    }
+};
+
+/// the niche of 'E' marks the good state, 'S' is stateless so nothing else has to be stored
+template <typename S, typename E>
+struct error_niche_storage {
+    // not const so the value can be moved from, 'S' has no state to modify
+    static inline S value_{};
+
+    E error_;
+
+    template <typename... Args>
+    explicit inline constexpr error_niche_storage(std::in_place_t, Args&&...) noexcept
+        : error_(niche_traits<E>::niche()) {}
+
+    template <typename... Args>
+    explicit inline constexpr error_niche_storage(error_tag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>)
+        : error_(std::forward<Args>(args)...) {}
+
+    template <typename... Args>
+    inline constexpr S& emplace_value(Args&&...) noexcept {
+        reconstruct(std::addressof(error_), niche_traits<E>::niche());
+        return value_;
+    }
+
+    template <typename... Args>
+    inline constexpr E& emplace_error(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>) {
+        reconstruct(std::addressof(error_), std::forward<Args>(args)...);
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr bool has_error() const noexcept {
+        return !niche_traits<E>::is_niche(error_);
+    }
+
+    [[nodiscard]]
+    inline constexpr S& value() noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const S& value() const noexcept {
+        return value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr E& error() noexcept {
+        return error_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const E& error() const noexcept {
+        return error_;
+    }
+};
+
+template <typename S, typename E>
+using storage_for = std::conditional_t<(has_niche<S> && is_stateless<E>),
+                                       value_niche_storage<S, E>,
+                                       std::conditional_t<(is_stateless<S> && has_niche<E>),
+                                                          error_niche_storage<S, E>,
+                                                          std::conditional_t<has_tail_padding<S, E>,
+                                                                             tail_padding_storage<S, E>,
+                                                                             tagged_storage<S, E>>>>;
+}
+
+/// Every reference has an address, so a null pointer is free to mark the error state.
+template <typename T>
+struct niche_traits<detail::reference_wrapper<T>> {
+    [[nodiscard]]
+    static inline constexpr detail::reference_wrapper<T> niche() noexcept {
+        return detail::reference_wrapper<T>(nullptr);
+    }
+
+    [[nodiscard]]
+    static inline constexpr bool is_niche(const detail::reference_wrapper<T>& value) noexcept {
+        return value.operator->() == nullptr;
+    }
+};
+
+template <typename>
+struct failure;
+
+template <typename T, typename E>
+struct result;
+
+namespace detail {
+template <typename>
+struct is_result : std::false_type {};
+
+template <typename T, typename E>
+struct is_result<result<T, E>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_result_v = is_result<T>::value;
+
+template <typename>
+struct storage_error_flag {
+    static inline constexpr bool available = false;
+    static inline constexpr std::size_t offset = 0;
+};
+
+// 'has_error_' directly follows the union of value and error
+template <typename S, typename E>
+struct storage_error_flag<tagged_storage<S, E>> {
+    static inline constexpr std::size_t union_align = alignof(S) > alignof(E) ? alignof(S) : alignof(E);
+    static inline constexpr std::size_t union_size = sizeof(S) > sizeof(E) ? sizeof(S) : sizeof(E);
+
+    static inline constexpr bool available = true;
+    static inline constexpr std::size_t offset = (union_size + union_align - 1) / union_align * union_align;
+};
+
+// the flag is a byte in the tail padding of 'S'
+template <typename S, typename E>
+struct storage_error_flag<tail_padding_storage<S, E>> {
+    static inline constexpr bool available = true;
+    static inline constexpr std::size_t offset = tail_padding_storage<S, E>::flag_offset;
+};
+
+/// Where a result keeps its error flag, used by the batch kernels ('res-cpp/batch.hpp').
+/// Only results with a tagged or tail padding storage have one, the niche storages encode the state in the value or error.
+template <typename R>
+struct result_layout {
+    using storage_type = decltype(R::storage_);
+
+    static inline constexpr bool has_error_flag = storage_error_flag<storage_type>::available;
+    static inline constexpr std::size_t error_flag_offset = storage_error_flag<storage_type>::offset;
+
+    /// value of a result known to hold one, skips the check of 'value()'
+    [[nodiscard]]
+    static inline constexpr const auto& unchecked_value(const R& res) noexcept {
+        return res.storage_.value();
+    }
+};
+
+/// Id of the error in the propagation trace kept by a 'result' or 'failure', see 'res-cpp/trace.hpp'.
+/// Only stored with 'RESCPP_ENABLE_TRACE', otherwise it's always '0' and the layout stays the same.
+struct trace_access {
+    template <typename R>
+    [[nodiscard]]
+    static inline constexpr std::uint64_t get([[maybe_unused]] const R& from) noexcept {
+#if defined(RESCPP_ENABLE_TRACE)
+        return from.trace_id_;
+#else
+        return 0;
+#endif
+    }
+
+    template <typename R>
+    static inline constexpr void set([[maybe_unused]] R& to, [[maybe_unused]] std::uint64_t id) noexcept {
+#if defined(RESCPP_ENABLE_TRACE)
+        to.trace_id_ = id;
+#endif
+    }
+
+    template <typename To, typename From>
+    static inline constexpr void copy(To& to, const From& from) noexcept {
+        set(to, get(from));
+    }
+};
+
+/// Converts an error the same way a 'failure' converts to a 'result' with another error type.
+template <typename To, typename From>
+inline constexpr To convert_error(From&& error) {
+    using from_type = std::remove_cvref_t<From>;
+    if constexpr (std::is_same_v<from_type, To>) {
+        return std::forward<From>(error);
+    }
+    else if constexpr (std::is_constructible_v<To, From>) {
+        return static_cast<To>(std::forward<From>(error));
+    }
+    else {
+        static_assert(has_type_converter<from_type, To>, "no conversion between the error types");
+        return type_converter<from_type, To>::convert(error);
+    }
+}
+
+// implementation of the result combinators, 'R' is a (const) reference to a result
 
-public:
-    inline constexpr reference_wrapper(T& ref) noexcept
-        : ptr(std::addressof(ref)) {}
+template <typename R>
+using result_value_t = typename std::remove_cvref_t<R>::value_type;
 
-    inline constexpr ~reference_wrapper() noexcept = default;
+template <typename R>
+using result_error_t = typename std::remove_cvref_t<R>::error_type;
 
-    inline constexpr T& get() const noexcept {
-        return *ptr;
+template <typename R, typename F>
+inline constexpr decltype(auto) invoke_with_value(R&& res, F&& f) {
+    if constexpr (std::is_void_v<result_value_t<R>>) {
+        return std::invoke(std::forward<F>(f));
     }
-
-    inline constexpr T* operator->() const noexcept {
-        return ptr;
+    else {
+        return std::invoke(std::forward<F>(f), std::forward<R>(res).value());
     }
+}
 
-    inline constexpr T& operator*() const noexcept {
-        return *ptr;
+template <typename R, typename F>
+using invoke_with_value_t = decltype(invoke_with_value(std::declval<R>(), std::declval<F>()));
+
+template <typename R, typename F>
+using invoke_with_error_t = std::invoke_result_t<F, decltype(std::declval<R>().error())>;
+
+/// 'result<T, E>' from a value which might be a reference or void
+template <typename V, typename E>
+using result_for_t = result<std::conditional_t<std::is_reference_v<V>, V, std::remove_cv_t<V>>, E>;
+
+/// passes the value of 'res' on to a result with another error type
+template <typename Next, typename R>
+inline constexpr Next pass_value(R&& res) {
+    if constexpr (std::is_void_v<result_value_t<R>>) {
+        return Next();
     }
-};
+    else {
+        return Next(std::in_place, std::forward<R>(res).value());
+    }
+}
 
-template <typename T>
-struct reference_wrapper<const T&> {
-private:
-    const T* ptr;
+template <typename R, typename F>
+inline constexpr auto and_then_impl(R&& res, F&& f) {
+    using next_type = std::remove_cvref_t<invoke_with_value_t<R, F>>;
+    static_assert(is_result_v<next_type>, "function passed to 'and_then' has to return a result");
 
-public:
-    inline constexpr reference_wrapper(const T& ref) noexcept
-        : ptr(std::addressof(ref)) {}
+    if (res.has_error()) {
+        next_type next(error, convert_error<typename next_type::error_type>(std::forward<R>(res).error()));
+        trace_access::copy(next, res);
+        return next;
+    }
+    return next_type(invoke_with_value(std::forward<R>(res), std::forward<F>(f)));
+}
 
-    inline constexpr ~reference_wrapper() noexcept = default;
+template <typename R, typename F>
+inline constexpr auto transform_impl(R&& res, F&& f) {
+    using value_type = invoke_with_value_t<R, F>;
+    using next_type = result_for_t<value_type, result_error_t<R>>;
 
-    inline constexpr const T& get() const noexcept {
-        return *ptr;
+    if (res.has_error()) {
+        next_type next(error, std::forward<R>(res).error());
+        trace_access::copy(next, res);
+        return next;
+    }
+    if constexpr (std::is_void_v<value_type>) {
+        invoke_with_value(std::forward<R>(res), std::forward<F>(f));
+        return next_type();
+    }
+    else {
+        return next_type(std::in_place, invoke_with_value(std::forward<R>(res), std::forward<F>(f)));
     }
+}
 
-    inline constexpr const T* operator->() const noexcept {
-        return ptr;
+template <typename R, typename F>
+inline constexpr auto transform_error_impl(R&& res, F&& f) {
+    using next_type = result<result_value_t<R>, std::remove_cvref_t<invoke_with_error_t<R, F>>>;
+
+    if (!res.has_error()) {
+        return pass_value<next_type>(std::forward<R>(res));
     }
+    // the mapped error is still the same failure for the trace
+    next_type next(error, std::invoke(std::forward<F>(f), std::forward<R>(res).error()));
+    trace_access::copy(next, res);
+    return next;
+}
 
-    inline constexpr operator const T&() const noexcept {
-        return *ptr;
+template <typename R, typename F>
+inline constexpr auto or_else_impl(R&& res, F&& f) {
+    using next_type = std::remove_cvref_t<invoke_with_error_t<R, F>>;
+    static_assert(is_result_v<next_type>, "function passed to 'or_else' has to return a result");
+    static_assert(std::is_same_v<typename next_type::value_type, result_value_t<R>>,
+                  "function passed to 'or_else' has to return a result with the same value type");
+
+    if (!res.has_error()) {
+        return pass_value<next_type>(std::forward<R>(res));
     }
-};
+    return next_type(std::invoke(std::forward<F>(f), std::forward<R>(res).error()));
 }
 
-template <typename>
-struct failure;
+template <typename R, typename F>
+inline constexpr auto value_or_else_impl(R&& res, F&& f) {
+    using value_type = result_value_t<R>;
+    using return_type = std::conditional_t<std::is_reference_v<value_type>, value_type, std::remove_cv_t<value_type>>;
+
+    if (!res.has_error()) {
+        return static_cast<return_type>(std::forward<R>(res).value());
+    }
+    return static_cast<return_type>(std::invoke(std::forward<F>(f), std::forward<R>(res).error()));
+}
+}
 
 template <typename T, typename E>
 struct result {
@@ -167,73 +1118,126 @@ private:
                                             detail::reference_wrapper<std::remove_volatile_t<value_type>>,
                                             std::remove_const_t<value_type>>;
 
-    union {
-        error_type error_;
-        storing_type value_;
-    };
+    detail::storage_for<storing_type, error_type> storage_;
+#if defined(RESCPP_ENABLE_TRACE)
+    std::uint64_t trace_id_ = 0;
+#endif
 
-    bool has_error_;
+    template <typename>
+    friend struct detail::result_layout;
+    friend struct detail::trace_access;
 
 public:
-    inline constexpr result(detail::error_tag, const error_type&& error) noexcept
-        : error_(std::forward<const error_type>(error)), has_error_(true) {}
+    inline constexpr result(detail::error_tag, const error_type& error)
+        noexcept(std::is_nothrow_copy_constructible_v<error_type>)
+        : storage_(detail::error, error) {}
 
-    inline constexpr result(value_type&& value) noexcept
-        : value_(std::forward<value_type>(value)), has_error_(false) {}
+    inline constexpr result(detail::error_tag, error_type&& error)
+        noexcept(std::is_nothrow_move_constructible_v<error_type>)
+        : storage_(detail::error, std::move(error)) {}
+
+    inline constexpr result(value_type&& value)
+        noexcept(std::is_nothrow_constructible_v<storing_type, value_type&&>)
+        : storage_(std::in_place, std::forward<value_type>(value)) {}
 
     template <typename... Args>
-    explicit inline constexpr result(std::in_place_t, Args&&... args) noexcept
-        : value_(std::forward<Args>(args)...), has_error_(false) {}
+    explicit inline constexpr result(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<storing_type, Args&&...>)
+        : storage_(std::in_place, std::forward<Args>(args)...) {}
+
+    /// constructs the value with uses allocator construction, e.g. 'std::pmr' types get 'alloc' passed
+    template <typename Alloc, typename... Args>
+        requires (!std::is_reference_v<value_type>)
+    inline constexpr result(std::allocator_arg_t, const Alloc& alloc, std::in_place_t, Args&&... args)
+        : storage_(std::in_place, detail::construct_using_allocator<storing_type>(alloc, std::forward<Args>(args)...)) {}
 
     template <typename T2>
         requires (!std::is_same_v<value_type, T2>
             && std::is_convertible_v<T2, value_type>)
     inline constexpr result(T2&& value)
         noexcept(std::is_nothrow_convertible_v<T2, value_type>)
-        : value_(static_cast<value_type>(std::forward<T2>(value))), has_error_(false) {}
-
-    inline constexpr result(const result& other)
-        noexcept(std::is_nothrow_copy_constructible_v<value_type>
-            && std::is_nothrow_copy_constructible_v<error_type>)
-        requires (std::is_copy_constructible_v<value_type>
-            && std::is_copy_constructible_v<error_type>)
-        : has_error_(other.has_error_) {
-        if (has_error_) {
-            std::construct_at(std::addressof(error_), other.error_);
+        : storage_(std::in_place, static_cast<value_type>(std::forward<T2>(value))) {}
+
+    // Guarantees when an exception is thrown:
+    // - copy / move assignment, same state: the one of the assignment of 'T' or 'E'
+    // - copy / move assignment, changed state: strong (see 'detail::reinit')
+    // - 'emplace' and 'emplace_error': strong if the type is nothrow constructible from 'args'
+    //   or nothrow move constructible, otherwise the one of its move assignment (see 'detail::reconstruct')
+    // - value and failure assignment: like copy / move assignment
+
+    /// Assigns 'value', in place when the result already holds a value (a string keeps its buffer),
+    /// otherwise like 'emplace'.
+    template <typename T2 = value_type>
+        requires (!std::is_reference_v<value_type>
+            && !detail::is_result_v<std::remove_cvref_t<T2>>
+            && std::is_constructible_v<storing_type, T2>
+            && std::is_assignable_v<storing_type&, T2>)
+    inline constexpr result& operator=(T2&& value)
+        noexcept(std::is_nothrow_constructible_v<storing_type, T2>
+            && std::is_nothrow_assignable_v<storing_type&, T2>) {
+        if (has_error()) {
+            storage_.emplace_value(std::forward<T2>(value));
         }
         else {
-            std::construct_at(std::addressof(value_), other.value_);
+            storage_.value() = std::forward<T2>(value);
         }
+        return *this;
     }
 
-    inline constexpr result(result&& other)
-        noexcept(std::is_nothrow_move_constructible_v<storing_type>
-            && std::is_nothrow_move_constructible_v<error_type>)
-        requires (std::is_move_constructible_v<storing_type>
-            && std::is_move_constructible_v<error_type>)
-        : has_error_(other.has_error_) {
-        if (has_error_) {
-            std::construct_at(std::addressof(error_), std::move(other.error_));
+    /// Assigns the error, in place when the result already holds one, otherwise like 'emplace_error'.
+    inline constexpr result& operator=(const failure<error_type>& error)
+        noexcept(std::is_nothrow_copy_constructible_v<error_type>
+            && std::is_nothrow_copy_assignable_v<error_type>) {
+        if (has_error()) {
+            storage_.error() = error.error();
         }
         else {
-            std::construct_at(std::addressof(value_), std::move(other.value_));
+            storage_.emplace_error(error.error());
         }
+        detail::trace_access::copy(*this, error);
+        return *this;
     }
 
-    inline constexpr ~result() noexcept {
-        if (has_error_ && std::is_destructible_v<error_type>) {
-            std::destroy_at(std::addressof(error_));
-            return;
+    inline constexpr result& operator=(failure<error_type>&& error)
+        noexcept(std::is_nothrow_move_constructible_v<error_type>
+            && std::is_nothrow_move_assignable_v<error_type>) {
+        if (has_error()) {
+            storage_.error() = std::move(error).error();
+        }
+        else {
+            storage_.emplace_error(std::move(error).error());
         }
+        detail::trace_access::copy(*this, error);
+        return *this;
+    }
 
-        if constexpr (std::is_destructible_v<storing_type> && !std::is_trivially_destructible_v<storing_type>) {
-            std::destroy_at(std::addressof(value_));
+    /// Replaces the value or error with a value constructed from 'args'.
+    template <typename... Args>
+        requires (!std::is_rvalue_reference_v<value_type>
+            && std::is_constructible_v<storing_type, Args...>)
+    inline constexpr return_value_type<value_type&> emplace(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<storing_type, Args...>) {
+        if constexpr (std::is_lvalue_reference_v<value_type>) {
+            return storage_.emplace_value(std::forward<Args>(args)...).get();
         }
+        else {
+            return storage_.emplace_value(std::forward<Args>(args)...);
+        }
+    }
+
+    /// Replaces the value or error with an error constructed from 'args'.
+    /// Unlike 'fail' it's not seen by the trace, stats or profiler hooks.
+    template <typename... Args>
+        requires (std::is_constructible_v<error_type, Args...>)
+    inline constexpr error_type& emplace_error(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<error_type, Args...>) {
+        detail::trace_access::set(*this, 0);
+        return storage_.emplace_error(std::forward<Args>(args)...);
     }
 
     [[nodiscard]]
     inline constexpr bool has_error() const noexcept {
-        return has_error_;
+        return storage_.has_error();
     }
 
     [[nodiscard]]
@@ -244,7 +1248,7 @@ public:
         }
 #endif
 
-        return error_;
+        return storage_.error();
     }
 
     [[nodiscard]]
@@ -255,7 +1259,18 @@ public:
         }
 #endif
 
-        return std::move(error_);
+        return std::move(storage_.error());
+    }
+
+    [[nodiscard]]
+    inline constexpr error_type&& error() && RESCPP_CHECKS_NOEXCEPT {
+#ifndef RESCPP_DISABLE_CHECKS
+        if (!has_error()) {
+            detail::throw_bad_error_access_exception();
+        }
+#endif
+
+        return std::move(storage_.error());
     }
 
     [[nodiscard]]
@@ -267,13 +1282,13 @@ public:
 #endif
 
         if constexpr (std::is_lvalue_reference_v<value_type>) {
-            return value_.get();
+            return storage_.value().get();
         }
         else if constexpr (std::is_rvalue_reference_v<value_type>) {
-            return std::move(value_);
+            return std::move(storage_.value());
         }
         else {
-            return value_;
+            return storage_.value();
         }
     }
 
@@ -286,13 +1301,13 @@ public:
 #endif
 
         if constexpr (std::is_lvalue_reference_v<value_type>) {
-            return value_.get();
+            return storage_.value().get();
         }
         else if constexpr (std::is_rvalue_reference_v<value_type>) {
-            return std::move(value_);
+            return std::move(storage_.value());
         }
         else {
-            return value_;
+            return storage_.value();
         }
     }
 
@@ -305,10 +1320,10 @@ public:
 #endif
 
         if constexpr (std::is_lvalue_reference_v<value_type>) {
-            return value_.get();
+            return storage_.value().get();
         }
         else {
-            return std::move(value_);
+            return std::move(storage_.value());
         }
     }
 
@@ -321,29 +1336,114 @@ public:
 #endif
 
         if constexpr (std::is_lvalue_reference_v<value_type>) {
-            return value_.get();
+            return storage_.value().get();
         }
         else {
-            return std::move(value_);
+            return std::move(storage_.value());
         }
     }
 
+    /// Calls 'f' with the value, which returns the next result.
+    /// An error gets passed on, converted like a 'failure'.
+    template <typename F>
+    inline constexpr auto and_then(F&& f) & {
+        return detail::and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto and_then(F&& f) const & {
+        return detail::and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto and_then(F&& f) && {
+        return detail::and_then_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Maps the value with 'f', an error gets passed on.
+    template <typename F>
+    inline constexpr auto transform(F&& f) & {
+        return detail::transform_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform(F&& f) const & {
+        return detail::transform_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform(F&& f) && {
+        return detail::transform_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Maps the error with 'f', a value gets passed on.
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) & {
+        return detail::transform_error_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) const & {
+        return detail::transform_error_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) && {
+        return detail::transform_error_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Calls 'f' with the error, which returns a result with the same value type.
+    template <typename F>
+    inline constexpr auto or_else(F&& f) & {
+        return detail::or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto or_else(F&& f) const & {
+        return detail::or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto or_else(F&& f) && {
+        return detail::or_else_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Returns the value or the value 'f' returns for the error.
+    template <typename F>
+    inline constexpr auto value_or_else(F&& f) & {
+        return detail::value_or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto value_or_else(F&& f) const & {
+        return detail::value_or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto value_or_else(F&& f) && {
+        return detail::value_or_else_impl(std::move(*this), std::forward<F>(f));
+    }
+
     template <typename T2, typename E2>
     inline constexpr operator result<T2, E2>() const & noexcept(std::is_nothrow_convertible_v<value_type, T2>
         && std::is_nothrow_convertible_v<error_type, E2>) {
         if (has_error()) {
-            return failure<error_type>(error_);
+            failure<error_type> passed(storage_.error());
+            detail::trace_access::copy(passed, *this);
+            return passed;
         }
-        return result<T2, E2>(value_);
+        return result<T2, E2>(storage_.value());
     }
 
     template <typename T2, typename E2>
-    inline constexpr operator result<T2, E2>() const && noexcept(std::is_nothrow_convertible_v<value_type, T2>
+    inline constexpr operator result<T2, E2>() && noexcept(std::is_nothrow_convertible_v<value_type, T2>
         && std::is_nothrow_convertible_v<error_type, E2>) {
         if (has_error()) {
-            return failure<error_type>(error_);
+            failure<error_type> passed(std::move(storage_.error()));
+            detail::trace_access::copy(passed, *this);
+            return passed;
         }
-        return result<T2, E2>(std::move(value_));
+        return result<T2, E2>(std::move(storage_.value()));
     }
 };
 
@@ -357,28 +1457,74 @@ struct result<void, E> {
                   "can not use references or pointer as error type");
 
 private:
-    const std::optional<error_type> error_;
+    detail::storage_for<detail::void_result_value, error_type> storage_;
+#if defined(RESCPP_ENABLE_TRACE)
+    std::uint64_t trace_id_ = 0;
+#endif
+
+    template <typename>
+    friend struct detail::result_layout;
+    friend struct detail::trace_access;
 
 public:
-    inline constexpr result(detail::error_tag, const error_type&& error) noexcept
-        : error_(std::forward<const error_type>(error)) {}
+    inline constexpr result(detail::error_tag, const error_type& error)
+        noexcept(std::is_nothrow_copy_constructible_v<error_type>)
+        : storage_(detail::error, error) {}
+
+    inline constexpr result(detail::error_tag, error_type&& error)
+        noexcept(std::is_nothrow_move_constructible_v<error_type>)
+        : storage_(detail::error, std::move(error)) {}
 
     inline constexpr result() noexcept
-        : error_(std::nullopt) {}
+        : storage_(std::in_place) {}
 
-    inline constexpr result(const result& other)
-        noexcept(std::is_nothrow_copy_constructible_v<error_type>)
-        requires (std::is_copy_constructible_v<error_type>)
-        : error_(other.error_) {}
+    // exception guarantees like 'result<T, E>'
 
-    inline constexpr result(result&& other)
-        noexcept(std::is_nothrow_move_constructible_v<error_type>)
-        requires (std::is_move_constructible_v<error_type>)
-        : error_(std::move(other.error_)) {}
+    /// Assigns the error, in place when the result already holds one, otherwise like 'emplace_error'.
+    inline constexpr result& operator=(const failure<error_type>& error)
+        noexcept(std::is_nothrow_copy_constructible_v<error_type>
+            && std::is_nothrow_copy_assignable_v<error_type>) {
+        if (has_error()) {
+            storage_.error() = error.error();
+        }
+        else {
+            storage_.emplace_error(error.error());
+        }
+        detail::trace_access::copy(*this, error);
+        return *this;
+    }
+
+    inline constexpr result& operator=(failure<error_type>&& error)
+        noexcept(std::is_nothrow_move_constructible_v<error_type>
+            && std::is_nothrow_move_assignable_v<error_type>) {
+        if (has_error()) {
+            storage_.error() = std::move(error).error();
+        }
+        else {
+            storage_.emplace_error(std::move(error).error());
+        }
+        detail::trace_access::copy(*this, error);
+        return *this;
+    }
+
+    /// Replaces an error with the good state.
+    inline constexpr void emplace() noexcept {
+        storage_.emplace_value();
+    }
+
+    /// Replaces the good state or error with an error constructed from 'args'.
+    /// Unlike 'fail' it's not seen by the trace, stats or profiler hooks.
+    template <typename... Args>
+        requires (std::is_constructible_v<error_type, Args...>)
+    inline constexpr error_type& emplace_error(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<error_type, Args...>) {
+        detail::trace_access::set(*this, 0);
+        return storage_.emplace_error(std::forward<Args>(args)...);
+    }
 
     [[nodiscard]]
     inline constexpr bool has_error() const noexcept {
-        return error_.has_value();
+        return storage_.has_error();
     }
 
     [[nodiscard]]
@@ -389,7 +1535,18 @@ public:
         }
 #endif
 
-        return error_.value();
+        return storage_.error();
+    }
+
+    [[nodiscard]]
+    inline constexpr error_type&& error() && RESCPP_CHECKS_NOEXCEPT {
+#ifndef RESCPP_DISABLE_CHECKS
+        if (!has_error()) {
+            detail::throw_bad_error_access_exception();
+        }
+#endif
+
+        return std::move(storage_.error());
     }
 
     [[nodiscard]]
@@ -400,7 +1557,72 @@ public:
         }
 #endif
 
-        return std::move(error_).value();
+        return std::move(storage_.error());
+    }
+
+    /// Calls 'f' with the value, which returns the next result.
+    /// An error gets passed on, converted like a 'failure'.
+    template <typename F>
+    inline constexpr auto and_then(F&& f) & {
+        return detail::and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto and_then(F&& f) const & {
+        return detail::and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto and_then(F&& f) && {
+        return detail::and_then_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Maps the value with 'f', an error gets passed on.
+    template <typename F>
+    inline constexpr auto transform(F&& f) & {
+        return detail::transform_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform(F&& f) const & {
+        return detail::transform_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform(F&& f) && {
+        return detail::transform_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Maps the error with 'f', a value gets passed on.
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) & {
+        return detail::transform_error_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) const & {
+        return detail::transform_error_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto transform_error(F&& f) && {
+        return detail::transform_error_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /// Calls 'f' with the error, which returns a result with the same value type.
+    template <typename F>
+    inline constexpr auto or_else(F&& f) & {
+        return detail::or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto or_else(F&& f) const & {
+        return detail::or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    inline constexpr auto or_else(F&& f) && {
+        return detail::or_else_impl(std::move(*this), std::forward<F>(f));
     }
 };
 
@@ -412,71 +1634,238 @@ struct failure {
                   "can not use references or pointer as error type");
 
 private:
-    const error_type error_;
+    error_type error_;
+#if defined(RESCPP_ENABLE_TRACE)
+    std::uint64_t trace_id_ = 0;
+#endif
+
+    friend struct detail::trace_access;
 
 public:
-    explicit inline constexpr failure(const E& error) noexcept
-        : error_(std::forward<const E>(error)) {}
+    explicit inline constexpr failure(const E& error)
+        noexcept(std::is_nothrow_copy_constructible_v<E>)
+        : error_(error) {}
 
-    explicit inline constexpr failure(const E&& error) noexcept
-        : error_(std::forward<const E>(error)) {}
+    explicit inline constexpr failure(E&& error)
+        noexcept(std::is_nothrow_move_constructible_v<E>)
+        : error_(std::move(error)) {}
 
     template <typename... Args>
-    inline constexpr failure(std::in_place_t, Args&&... args) noexcept
+    inline constexpr failure(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<E, Args...>)
         : error_(std::forward<Args>(args)...) {}
 
+    /// constructs the error with uses allocator construction, e.g. 'std::pmr' types get 'alloc' passed
+    template <typename Alloc, typename... Args>
+    inline constexpr failure(std::allocator_arg_t, const Alloc& alloc, Args&&... args)
+        : error_(std::make_obj_using_allocator<E>(alloc, std::forward<Args>(args)...)) {}
+
     [[nodiscard]]
     inline constexpr const error_type& error() const & noexcept {
         return error_;
     }
 
+    [[nodiscard]]
+    inline constexpr error_type&& error() && noexcept {
+        return std::move(error_);
+    }
+
     [[nodiscard]]
     inline constexpr const error_type&& error() const && noexcept {
         return std::move(error_);
     }
 
     template <typename T>
-    inline constexpr operator result<T, error_type>() const noexcept {
-        return result<T, error_type>(detail::error, std::move(error_));
+    inline constexpr operator result<T, error_type>() const &
+        noexcept(std::is_nothrow_copy_constructible_v<error_type>) {
+        result<T, error_type> res(detail::error, error_);
+        detail::trace_access::copy(res, *this);
+        return res;
+    }
+
+    template <typename T>
+    inline constexpr operator result<T, error_type>() &&
+        noexcept(std::is_nothrow_move_constructible_v<error_type>) {
+        result<T, error_type> res(detail::error, std::move(error_));
+        detail::trace_access::copy(res, *this);
+        return res;
+    }
+
+    template <typename T, typename E2>
+        requires (!std::is_same_v<error_type, E2> && std::is_constructible_v<E2, const error_type&>)
+    inline constexpr operator result<T, E2>() const & noexcept(std::is_nothrow_constructible_v<E2, const error_type&>) {
+        result<T, E2> res(detail::error, static_cast<E2>(error_));
+        detail::trace_access::copy(res, *this);
+        return res;
     }
 
     template <typename T, typename E2>
         requires (!std::is_same_v<error_type, E2> && std::is_constructible_v<E2, error_type>)
-    inline constexpr operator result<T, E2>() const noexcept(std::is_nothrow_constructible_v<E2, error_type>) {
-        return result<T, E2>(detail::error, static_cast<E2>(error_));
+    inline constexpr operator result<T, E2>() && noexcept(std::is_nothrow_constructible_v<E2, error_type>) {
+        result<T, E2> res(detail::error, static_cast<E2>(std::move(error_)));
+        detail::trace_access::copy(res, *this);
+        return res;
     }
 
     template <typename T, typename E2>
         requires (!std::is_same_v<error_type, E2> && !std::is_constructible_v<E2, error_type>
             && detail::has_type_converter<std::remove_cvref_t<error_type>, std::remove_cvref_t<E2>>)
-    inline constexpr operator result<T, E2>() const noexcept {
-        return result<T, E2>(detail::error,
-                             type_converter<
-                                 std::remove_cvref_t<error_type>,
-                                 std::remove_cvref_t<E2>
-                             >::convert(error_)
+    inline constexpr operator result<T, E2>() const & noexcept {
+        result<T, E2> res(detail::error,
+                          type_converter<
+                              std::remove_cvref_t<error_type>,
+                              std::remove_cvref_t<E2>
+                          >::convert(error_)
         );
+        detail::trace_access::copy(res, *this);
+        return res;
+    }
+};
+
+namespace detail {
+/// new errors start a new propagation trace, returns the id to stamp into the failure, see 'res-cpp/trace.hpp'
+[[nodiscard]]
+inline constexpr std::uint64_t trace_begin_error() noexcept {
+#if defined(RESCPP_ENABLE_TRACE)
+    if (!std::is_constant_evaluated()) {
+        return trace::begin_error();
+    }
+#endif
+    return 0;
+}
+
+#if defined(RESCPP_ENABLE_TRACE)
+using trace_location = std::source_location;
+#else
+/// nothing to pass around without 'RESCPP_ENABLE_TRACE'
+struct trace_location {
+    [[nodiscard]]
+    static inline constexpr trace_location current() noexcept {
+        return {};
     }
 };
+#endif
+
+/// records a propagation hop of the error in 'res' without try macro, e.g. 'co_await'
+template <typename R>
+inline void trace_hop([[maybe_unused]] const R& res, [[maybe_unused]] const trace_location& location) noexcept {
+#if defined(RESCPP_ENABLE_TRACE)
+    trace::record_hop(trace_access::get(res), location);
+#endif
+}
+}
+
+#if defined(RESCPP_ENABLE_TRACE)
+namespace trace {
+/// id of the error in 'res', '0' for a result with a value or an error not created with 'fail'
+template <typename R>
+    requires (detail::is_result_v<R>)
+[[nodiscard]]
+inline std::uint64_t error_id(const R& res) noexcept {
+    return res.has_error() ? detail::trace_access::get(res) : 0;
+}
+}
+#endif
+
+namespace detail {
+
+#if defined(RESCPP_ENABLE_STATS)
+/// counts a new error of type 'E', see 'res-cpp/stats.hpp'
+template <typename E>
+inline constexpr void stats_created(const std::source_location& location) noexcept {
+    if (!std::is_constant_evaluated()) {
+        stats::record<E>(stats::event::created, location);
+    }
+}
+#endif
+
+/// counts a new error of type 'E' without call site
+template <typename E>
+inline constexpr void stats_created() noexcept {
+#if defined(RESCPP_ENABLE_STATS)
+    stats_created<E>(std::source_location());
+#endif
+}
+
+/// samples the stack of a new error of type 'E', see 'res-cpp/profiler.hpp'
+template <typename E>
+inline constexpr void profiler_sample() noexcept {
+#if defined(RESCPP_ENABLE_PROFILER)
+    if (!std::is_constant_evaluated()) {
+        profiler::sample<E>();
+    }
+#endif
+}
+
+/// counts a propagated error of type 'E' without call site, e.g. 'co_await'
+template <typename E>
+inline void stats_propagated() noexcept {
+#if defined(RESCPP_ENABLE_STATS)
+    stats::record<E>(stats::event::propagated, std::source_location());
+#endif
+}
+}
 
+#if defined(RESCPP_ENABLE_STATS)
 template <typename E>
-inline constexpr failure<E> fail(const E&& error) noexcept {
-    return failure<E>(std::forward<const E>(error));
+inline constexpr failure<std::remove_cvref_t<E>> fail(E&& error, const std::source_location& location = std::source_location::current())
+    noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<E>, E>) {
+    detail::stats_created<std::remove_cvref_t<E>>(location);
+    detail::profiler_sample<std::remove_cvref_t<E>>();
+    failure<std::remove_cvref_t<E>> created(std::forward<E>(error));
+    detail::trace_access::set(created, detail::trace_begin_error());
+    return created;
 }
+#else
+template <typename E>
+inline constexpr failure<std::remove_cvref_t<E>> fail(E&& error)
+    noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<E>, E>) {
+    detail::profiler_sample<std::remove_cvref_t<E>>();
+    failure<std::remove_cvref_t<E>> created(std::forward<E>(error));
+    detail::trace_access::set(created, detail::trace_begin_error());
+    return created;
+}
+#endif
 
+// no call site, an argument with a default can not follow 'args'
 template <typename E, typename... Args>
-inline constexpr failure<E> fail(Args&&... args) noexcept {
-    return failure<E>(std::in_place, std::forward<Args>(args)...);
+inline constexpr failure<E> fail(Args&&... args)
+    noexcept(std::is_nothrow_constructible_v<E, Args...>) {
+    detail::stats_created<E>();
+    detail::profiler_sample<E>();
+    failure<E> created(std::in_place, std::forward<Args>(args)...);
+    detail::trace_access::set(created, detail::trace_begin_error());
+    return created;
+}
+
+/// e.g. 'rescpp::fail<error>(std::allocator_arg, arena.allocator(), "message")'
+template <typename E, typename Alloc, typename... Args>
+inline constexpr failure<E> fail(std::allocator_arg_t, Alloc&& alloc, Args&&... args) {
+    detail::stats_created<E>();
+    detail::profiler_sample<E>();
+    failure<E> created(std::allocator_arg, alloc, std::forward<Args>(args)...);
+    detail::trace_access::set(created, detail::trace_begin_error());
+    return created;
 }
 
 template <typename E>
-inline constexpr failure<E> fail(detail::pass_error_tag, const E&& error) noexcept {
-    return failure<E>(std::forward<const E>(error));
+    requires (!detail::is_result_v<std::remove_cvref_t<E>>)
+inline constexpr failure<std::remove_cvref_t<E>> fail(detail::pass_error_tag, E&& error)
+    noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<E>, E>) {
+    return failure<std::remove_cvref_t<E>>(std::forward<E>(error));
 }
 
-namespace detail {
-struct void_result_value {};
+/// passes the error of 'res' on, it keeps its propagation trace id
+template <typename R>
+    requires (detail::is_result_v<std::remove_cvref_t<R>>)
+inline constexpr failure<detail::result_error_t<R>> fail(detail::pass_error_tag, R&& res)
+    noexcept(std::is_nothrow_constructible_v<detail::result_error_t<R>, decltype(std::forward<R>(res).error())>) {
+    failure<detail::result_error_t<R>> passed(std::forward<R>(res).error());
+    detail::trace_access::copy(passed, res);
+    return passed;
+}
 
+namespace detail {
 template <typename E>
 inline constexpr void_result_value try_helper(const result<void, E>) {
     return {};
@@ -503,22 +1892,54 @@ inline constexpr T try_helper(const result<T, E> res) {
 
 #if !defined(RESCPP_DISABLE_TRY_MACRO)
 
+// Branch hint for the error branch of the try macros.
+// 'unlikely' by default, which moves the propagation code out of the hot path
+// (GCC moves it behind the return of the hot path and optimizes it for size).
+#if !defined(RESCPP_TRY_ERROR_HINT)
+#if defined(RESCPP_TRY_ERROR_LIKELY)
+#define RESCPP_TRY_ERROR_HINT [[likely]]
+#elif defined(RESCPP_TRY_NO_BRANCH_HINT)
+#define RESCPP_TRY_ERROR_HINT
+#else
+#define RESCPP_TRY_ERROR_HINT [[unlikely]]
+#endif
+#endif
+
 /// WARNING: NOT 'constexpr' compatible
 /// 'result_' is the used identifier for the result object.
 #define RESCPP_TRY_IMPL(expr, ...) \
     ::rescpp::detail::try_helper(({ \
         auto result_ = (expr); \
-        if (result_.has_error()) { \
+        if (result_.has_error()) RESCPP_TRY_ERROR_HINT { \
             __VA_ARGS__ \
         } \
-        result_; \
+        std::move(result_); \
     }))
 
+// Records the propagation hop of the error in 'res' with 'RESCPP_ENABLE_TRACE', nothing otherwise.
+#if defined(RESCPP_ENABLE_TRACE)
+#define RESCPP_TRACE_HOP(res) \
+    ::rescpp::trace::record_hop(::rescpp::detail::trace_access::get(res), std::source_location::current());
+#else
+#define RESCPP_TRACE_HOP(res)
+#endif
+
+// Counts the propagated error with 'RESCPP_ENABLE_STATS', nothing otherwise.
+#if defined(RESCPP_ENABLE_STATS)
+#define RESCPP_STATS_HOP(res) \
+    ::rescpp::stats::record<typename std::remove_cvref_t<decltype(res)>::error_type>( \
+        ::rescpp::stats::event::propagated, std::source_location::current());
+#else
+#define RESCPP_STATS_HOP(res)
+#endif
+
 /// WARNING: NOT 'constexpr' compatible
 #define RESCPP_TRY(...) \
     RESCPP_TRY_IMPL((__VA_ARGS__), \
+        RESCPP_TRACE_HOP(result_) \
+        RESCPP_STATS_HOP(result_) \
         return ::rescpp::fail(::rescpp::detail::pass_error, \
-            std::move(result_.error()) \
+            std::move(result_) \
         ); \
     )
 
@@ -534,15 +1955,17 @@ inline constexpr T try_helper(const result<T, E> res) {
 #define RESCPP_TRY_IMPL_(name, expr, ...) \
     auto RESCPP_TRY_RESULT_NAME(name) = (expr); \
     using RESCPP_TRY_RESULT_TYPE(name) = decltype(RESCPP_TRY_RESULT_NAME(name)); \
-    if (RESCPP_TRY_RESULT_NAME(name).has_error()) { \
+    if (RESCPP_TRY_RESULT_NAME(name).has_error()) RESCPP_TRY_ERROR_HINT { \
         __VA_ARGS__ \
     } \
     typename std::conditional_t<std::is_void_v<RESCPP_TRY_RESULT_TYPE(name)::value_type>, ::rescpp::detail::void_result_value, RESCPP_TRY_RESULT_TYPE(name)::value_type> name = ::rescpp::detail::try_helper(std::move(RESCPP_TRY_RESULT_NAME(name)))
 
 #define RESCPP_TRY_(name, ...) \
     RESCPP_TRY_IMPL_(name, (__VA_ARGS__), \
+        RESCPP_TRACE_HOP(RESCPP_TRY_RESULT_NAME(name)) \
+        RESCPP_STATS_HOP(RESCPP_TRY_RESULT_NAME(name)) \
         return ::rescpp::fail(::rescpp::detail::pass_error, \
-            std::move(RESCPP_TRY_RESULT_NAME(name)).error() \
+            std::move(RESCPP_TRY_RESULT_NAME(name)) \
         ); \
     )
 
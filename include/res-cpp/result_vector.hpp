@@ -0,0 +1,290 @@
+#ifndef RESCPP_RESULT_VECTOR_H
+#define RESCPP_RESULT_VECTOR_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "res-cpp.hpp"
+
+// Container of results stored as structure of arrays:
+// - values in a dense 'T' array, with a value initialized 'T' in the slots of errors
+// - one bit per element telling if it is an error
+// - errors packed with their position, errors are expected to be rare
+//
+// Batch code can scan the bitmap and the value array instead of whole results,
+// 'values()' and 'errors()' visit only one side.
+
+namespace rescpp {
+/// Element of a 'result_vector', refers into the vector.
+template <typename T, typename E>
+class result_view {
+    const T* value_;
+    const E* error_;
+
+public:
+    inline constexpr result_view(const T* value, const E* error) noexcept
+        : value_(value), error_(error) {}
+
+    [[nodiscard]]
+    inline constexpr bool has_error() const noexcept {
+        return error_ != nullptr;
+    }
+
+    [[nodiscard]]
+    inline constexpr const T& value() const RESCPP_CHECKS_NOEXCEPT {
+#ifndef RESCPP_DISABLE_CHECKS
+        if (has_error()) {
+            detail::throw_bad_value_access_exception();
+        }
+#endif
+
+        return *value_;
+    }
+
+    [[nodiscard]]
+    inline constexpr const E& error() const RESCPP_CHECKS_NOEXCEPT {
+#ifndef RESCPP_DISABLE_CHECKS
+        if (!has_error()) {
+            detail::throw_bad_error_access_exception();
+        }
+#endif
+
+        return *error_;
+    }
+};
+
+template <typename T, typename E>
+class result_vector {
+    static_assert(!std::is_reference_v<T> && !std::is_void_v<T>,
+                  "result_vector needs a value type");
+    static_assert(std::is_default_constructible_v<T>,
+                  "result_vector fills the value slots of errors with a value initialized 'T'");
+
+public:
+    using value_type = T;
+    using error_type = E;
+    using word_type = std::uint64_t;
+
+    static inline constexpr std::size_t word_bits = 64;
+
+    struct indexed_error {
+        std::size_t index;
+        E error;
+    };
+
+private:
+    std::vector<T> values_;
+    std::vector<word_type> error_bits_;
+    std::vector<indexed_error> errors_;
+
+    template <typename R>
+    inline void push(R&& res) {
+        const std::size_t index = values_.size();
+        if (error_bits_.size() <= index / word_bits) {
+            error_bits_.push_back(0);
+        }
+
+        if (!res.has_error()) {
+            values_.push_back(std::forward<R>(res).value());
+            return;
+        }
+
+        values_.emplace_back();
+#if defined(__cpp_exceptions)
+        try {
+            errors_.push_back(indexed_error{ index, std::forward<R>(res).error() });
+        }
+        catch (...) {
+            values_.pop_back();
+            throw;
+        }
+#else
+        errors_.push_back(indexed_error{ index, std::forward<R>(res).error() });
+#endif
+        error_bits_[index / word_bits] |= word_type(1) << (index % word_bits);
+    }
+
+    /// bits of the elements in word 'word_index' which hold a value
+    [[nodiscard]]
+    inline word_type value_bits(std::size_t word_index) const noexcept {
+        const std::size_t used = values_.size() - word_index * word_bits;
+        const word_type used_mask = used >= word_bits ? ~word_type(0) : (word_type(1) << used) - 1;
+        return ~error_bits_[word_index] & used_mask;
+    }
+
+    [[nodiscard]]
+    inline const E* find_error(std::size_t index) const noexcept {
+        // indices are pushed in order, so they are sorted
+        std::size_t first = 0;
+        std::size_t count = errors_.size();
+        while (count > 0) {
+            const std::size_t step = count / 2;
+            if (errors_[first + step].index < index) {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else {
+                count = step;
+            }
+        }
+        return &errors_[first].error;
+    }
+
+public:
+    /// iterates over the elements holding a value, word by word through the bitmap
+    class value_iterator {
+        const result_vector* vector_ = nullptr;
+        std::size_t word_index_ = 0;
+        // elements of the current word holding a value which were not visited yet
+        word_type remaining_ = 0;
+
+        inline void skip_empty_words() noexcept {
+            const std::size_t word_count = vector_->error_bits_.size();
+            while (remaining_ == 0 && ++word_index_ < word_count) {
+                remaining_ = vector_->value_bits(word_index_);
+            }
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        value_iterator() = default;
+
+        inline value_iterator(const result_vector* vector, std::size_t word_index) noexcept
+            : vector_(vector), word_index_(word_index) {
+            if (word_index_ < vector_->error_bits_.size()) {
+                remaining_ = vector_->value_bits(word_index_);
+                skip_empty_words();
+            }
+        }
+
+        /// position of the element in the vector
+        [[nodiscard]]
+        inline std::size_t index() const noexcept {
+            return word_index_ * word_bits + static_cast<std::size_t>(std::countr_zero(remaining_));
+        }
+
+        [[nodiscard]]
+        inline const T& operator*() const noexcept {
+            return vector_->values_[index()];
+        }
+
+        inline value_iterator& operator++() noexcept {
+            // clear the lowest bit
+            remaining_ &= remaining_ - 1;
+            if (remaining_ == 0) {
+                skip_empty_words();
+            }
+            return *this;
+        }
+
+        inline value_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]]
+        inline bool operator==(const value_iterator& other) const noexcept {
+            return word_index_ == other.word_index_ && remaining_ == other.remaining_;
+        }
+    };
+
+    struct value_range {
+        value_iterator begin_;
+        value_iterator end_;
+
+        [[nodiscard]]
+        inline value_iterator begin() const noexcept {
+            return begin_;
+        }
+
+        [[nodiscard]]
+        inline value_iterator end() const noexcept {
+            return end_;
+        }
+    };
+
+    result_vector() = default;
+
+    inline void reserve(std::size_t capacity) {
+        values_.reserve(capacity);
+        error_bits_.reserve((capacity + word_bits - 1) / word_bits);
+    }
+
+    inline void push_back(const result<T, E>& res) {
+        push(res);
+    }
+
+    inline void push_back(result<T, E>&& res) {
+        push(std::move(res));
+    }
+
+    inline void clear() noexcept {
+        values_.clear();
+        error_bits_.clear();
+        errors_.clear();
+    }
+
+    [[nodiscard]]
+    inline std::size_t size() const noexcept {
+        return values_.size();
+    }
+
+    [[nodiscard]]
+    inline bool empty() const noexcept {
+        return values_.empty();
+    }
+
+    [[nodiscard]]
+    inline std::size_t error_count() const noexcept {
+        return errors_.size();
+    }
+
+    [[nodiscard]]
+    inline bool has_error(std::size_t index) const noexcept {
+        return (error_bits_[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    [[nodiscard]]
+    inline result_view<T, E> operator[](std::size_t index) const noexcept {
+        if (has_error(index)) {
+            return result_view<T, E>(nullptr, find_error(index));
+        }
+        return result_view<T, E>(&values_[index], nullptr);
+    }
+
+    /// only the elements holding a value
+    [[nodiscard]]
+    inline value_range values() const noexcept {
+        return { value_iterator(this, 0), value_iterator(this, error_bits_.size()) };
+    }
+
+    /// only the errors with their position, in order
+    [[nodiscard]]
+    inline std::span<const indexed_error> errors() const noexcept {
+        return errors_;
+    }
+
+    /// all value slots, slots of errors hold a value initialized 'T'
+    [[nodiscard]]
+    inline std::span<const T> value_slots() const noexcept {
+        return values_;
+    }
+
+    /// bit 'i % 64' of word 'i / 64' is set if element 'i' is an error, unused bits are zero
+    [[nodiscard]]
+    inline std::span<const word_type> error_bits() const noexcept {
+        return error_bits_;
+    }
+};
+}
+
+#endif //RESCPP_RESULT_VECTOR_H
@@ -0,0 +1,626 @@
+#ifndef RESCPP_SENDER_H
+#define RESCPP_SENDER_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "parallel.hpp"
+#include "res-cpp.hpp"
+
+// Small sender / receiver layer in the style of P2300, results complete through the channels:
+// values go to 'set_value', errors of results to 'set_error'. Nothing is allocated on the heap,
+// adaptors wrap the receiver and 'let_result' keeps the next operation inside its own.
+//
+// A sender has 'value_type' and 'error_type' ('void' if it never fails) and 'connect(receiver) &&',
+// which returns an operation with 'start() noexcept'. A receiver has 'set_value(value)'
+// ('set_value()' for 'void'), 'set_error(error)' and 'set_error(std::exception_ptr)'. Stopping is not supported.
+// Functions passed to 'then_result' and 'let_result' may throw, the exception goes to 'set_error(std::exception_ptr)'
+// instead of escaping 'start()', 'sync_wait' rethrows it.
+// 'sync_wait(loop, sender)' runs 'loop' on the calling thread until 'sender' completes,
+// 'sync_wait(sender)' only runs a private loop, it waits for senders completing on other threads (e.g. a 'thread_pool').
+//
+//   rescpp::run_loop loop;
+//   auto work = rescpp::schedule(loop.get_scheduler())
+//       | rescpp::then_result([] { return read_config(); })
+//       | rescpp::let_result([](config cfg) { return rescpp::as_sender(connect_to(cfg.host)); });
+//   rescpp::result<connection, error> res = rescpp::sync_wait(loop, std::move(work));
+
+namespace rescpp {
+/// marks a type as sender, has to be named 'sender_concept' in the sender
+struct sender_tag {};
+
+namespace detail {
+template <typename S>
+concept sender = std::is_same_v<typename std::remove_cvref_t<S>::sender_concept, sender_tag>;
+
+template <typename S>
+using sender_value_t = typename std::remove_cvref_t<S>::value_type;
+
+template <typename S>
+using sender_error_t = typename std::remove_cvref_t<S>::error_type;
+
+template <typename S, typename Receiver>
+using connect_result_t = decltype(std::declval<std::remove_cvref_t<S>>().connect(std::declval<Receiver>()));
+
+/// calls 'set_value' of 'receiver' with the value of 'res', or 'set_error' with its error
+template <typename Receiver, typename R>
+inline void complete_with(Receiver& receiver, R&& res) {
+    if (res.has_error()) {
+        std::move(receiver).set_error(std::forward<R>(res).error());
+    }
+    else if constexpr (std::is_void_v<result_value_t<R>>) {
+        std::move(receiver).set_value();
+    }
+    else {
+        std::move(receiver).set_value(std::forward<R>(res).value());
+    }
+}
+
+/// Converts to the result of 'f', lets 'std::optional::emplace' construct operations which can not be moved.
+template <typename F>
+struct emplace_from {
+    F f;
+
+    inline operator std::invoke_result_t<F&>() {
+        return f();
+    }
+};
+
+template <typename F>
+emplace_from(F) -> emplace_from<F>;
+}
+
+/// connects a sender, lvalue senders get copied
+template <typename S, typename Receiver>
+    requires (detail::sender<S>)
+[[nodiscard]]
+inline auto connect(S&& sender, Receiver&& receiver) {
+    return std::remove_cvref_t<S>(std::forward<S>(sender)).connect(std::forward<Receiver>(receiver));
+}
+
+/// Sends the value of a result to 'set_value' and its error to 'set_error'.
+template <typename T, typename E>
+class result_sender {
+    result<T, E> result_;
+
+public:
+    using sender_concept = sender_tag;
+    using value_type = T;
+    using error_type = E;
+
+    template <typename Receiver>
+    struct operation {
+        result<T, E> result_;
+        Receiver receiver_;
+
+        inline void start() noexcept {
+            detail::complete_with(receiver_, std::move(result_));
+        }
+    };
+
+    explicit inline result_sender(result<T, E> res)
+        : result_(std::move(res)) {}
+
+    template <typename Receiver>
+    [[nodiscard]]
+    inline operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) && {
+        return { std::move(result_), std::forward<Receiver>(receiver) };
+    }
+};
+
+template <typename R>
+    requires (detail::is_result_v<std::remove_cvref_t<R>>)
+[[nodiscard]]
+inline result_sender<detail::result_value_t<R>, detail::result_error_t<R>> as_sender(R&& res) {
+    return result_sender<detail::result_value_t<R>, detail::result_error_t<R>>(std::forward<R>(res));
+}
+
+namespace detail {
+/// result of calling 'F' with a value 'V', 'void' values call it without arguments
+template <typename F, typename V>
+struct value_call {
+    using type = std::remove_cvref_t<std::invoke_result_t<F&, V>>;
+};
+
+template <typename F>
+struct value_call<F, void> {
+    using type = std::remove_cvref_t<std::invoke_result_t<F&>>;
+};
+
+template <typename S, typename F>
+using then_result_t = typename value_call<F, sender_value_t<S>>::type;
+
+/// Calls 'f' with the value, the returned result completes 'receiver_'.
+template <typename F, typename Receiver, typename E>
+struct then_result_receiver {
+    F f_;
+    Receiver receiver_;
+
+    template <typename... Args>
+    inline void set_value(Args&&... args) && {
+#if defined(__cpp_exceptions)
+        try {
+#endif
+            detail::complete_with(receiver_, std::invoke(f_, std::forward<Args>(args)...));
+#if defined(__cpp_exceptions)
+        }
+        catch (...) {
+            std::move(receiver_).set_error(std::current_exception());
+        }
+#endif
+    }
+
+    template <typename A>
+    inline void set_error(A&& error) && {
+        std::move(receiver_).set_error(convert_error<E>(std::forward<A>(error)));
+    }
+
+    inline void set_error(std::exception_ptr error) && {
+        std::move(receiver_).set_error(std::move(error));
+    }
+};
+
+template <typename S, typename F>
+class then_result_sender {
+    using next_type = then_result_t<S, F>;
+    static_assert(is_result_v<next_type>, "function passed to 'then_result' has to return a result");
+
+    S sender_;
+    F f_;
+
+public:
+    using sender_concept = sender_tag;
+    using value_type = typename next_type::value_type;
+    using error_type = typename next_type::error_type;
+
+    inline then_result_sender(S sender, F f)
+        : sender_(std::move(sender)), f_(std::move(f)) {}
+
+    template <typename Receiver>
+    [[nodiscard]]
+    inline auto connect(Receiver&& receiver) && {
+        return std::move(sender_).connect(then_result_receiver<F, std::remove_cvref_t<Receiver>, error_type>{
+            std::move(f_), std::forward<Receiver>(receiver) });
+    }
+};
+
+/// value of a sender stored in an operation, 'void' values store nothing
+template <typename V>
+struct stored_value {
+    std::optional<std::conditional_t<std::is_reference_v<V>, std::reference_wrapper<std::remove_reference_t<V>>, V>> value_;
+
+    template <typename A>
+    inline void store(A&& value) {
+        value_.emplace(std::forward<A>(value));
+    }
+
+    template <typename F>
+    inline decltype(auto) call(F& f) {
+        if constexpr (std::is_reference_v<V>) {
+            return std::invoke(f, value_->get());
+        }
+        else {
+            return std::invoke(f, *value_);
+        }
+    }
+};
+
+template <>
+struct stored_value<void> {
+    inline void store() noexcept {}
+
+    template <typename F>
+    inline decltype(auto) call(F& f) {
+        return std::invoke(f);
+    }
+};
+
+/// 'f' gets the stored value as lvalue
+template <typename S, typename F>
+using let_result_next_t = typename value_call<F, std::add_lvalue_reference_t<sender_value_t<S>>>::type;
+
+template <typename S, typename F, typename Receiver>
+class let_result_operation {
+    using next_sender = let_result_next_t<S, F>;
+    using error_type = sender_error_t<next_sender>;
+
+    struct first_receiver {
+        let_result_operation* operation_;
+
+        template <typename... Args>
+        inline void set_value(Args&&... args) && {
+            operation_->start_next(std::forward<Args>(args)...);
+        }
+
+        template <typename A>
+        inline void set_error(A&& error) && {
+            std::move(operation_->receiver_).set_error(convert_error<error_type>(std::forward<A>(error)));
+        }
+
+        inline void set_error(std::exception_ptr error) && {
+            std::move(operation_->receiver_).set_error(std::move(error));
+        }
+    };
+
+    using first_operation = connect_result_t<S, first_receiver>;
+    using next_operation = connect_result_t<next_sender, Receiver>;
+
+    F f_;
+    Receiver receiver_;
+    stored_value<sender_value_t<S>> value_;
+    first_operation first_;
+    std::optional<next_operation> next_;
+
+    template <typename... Args>
+    inline void start_next(Args&&... args) {
+#if defined(__cpp_exceptions)
+        try {
+#endif
+            // the value lives in the operation, senders returned by 'f' may refer to it
+            value_.store(std::forward<Args>(args)...);
+            next_.emplace(emplace_from{ [this] {
+                return value_.call(f_).connect(std::move(receiver_));
+            } });
+#if defined(__cpp_exceptions)
+        }
+        catch (...) {
+            std::move(receiver_).set_error(std::current_exception());
+            return;
+        }
+#endif
+        next_->start();
+    }
+
+public:
+    inline let_result_operation(S&& sender, F&& f, Receiver&& receiver)
+        : f_(std::move(f)), receiver_(std::move(receiver)), first_(std::move(sender).connect(first_receiver{ this })) {}
+
+    let_result_operation(const let_result_operation&) = delete;
+    let_result_operation& operator=(const let_result_operation&) = delete;
+
+    inline void start() noexcept {
+        first_.start();
+    }
+};
+
+template <typename S, typename F>
+class let_result_sender {
+    using next_sender = let_result_next_t<S, F>;
+    static_assert(sender<next_sender>, "function passed to 'let_result' has to return a sender");
+
+    S sender_;
+    F f_;
+
+public:
+    using sender_concept = sender_tag;
+    using value_type = sender_value_t<next_sender>;
+    using error_type = sender_error_t<next_sender>;
+
+    inline let_result_sender(S sender, F f)
+        : sender_(std::move(sender)), f_(std::move(f)) {}
+
+    template <typename Receiver>
+    [[nodiscard]]
+    inline let_result_operation<S, F, std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) && {
+        return { std::move(sender_), std::move(f_), std::remove_cvref_t<Receiver>(std::forward<Receiver>(receiver)) };
+    }
+};
+
+template <template <typename, typename> typename Sender, typename F>
+struct sender_closure {
+    F f_;
+
+    template <typename S>
+        requires (sender<S>)
+    friend inline auto operator|(S&& sender, sender_closure closure) {
+        return Sender<std::remove_cvref_t<S>, F>(std::forward<S>(sender), std::move(closure.f_));
+    }
+};
+}
+
+/// Calls 'f' with the value of 'sender', the result of 'f' completes the returned sender.
+template <typename S, typename F>
+    requires (detail::sender<S>)
+[[nodiscard]]
+inline detail::then_result_sender<std::remove_cvref_t<S>, std::decay_t<F>> then_result(S&& sender, F&& f) {
+    return { std::forward<S>(sender), std::forward<F>(f) };
+}
+
+template <typename F>
+[[nodiscard]]
+inline detail::sender_closure<detail::then_result_sender, std::decay_t<F>> then_result(F&& f) {
+    return { std::forward<F>(f) };
+}
+
+/// Calls 'f' with the value of 'sender', the sender returned by 'f' completes the returned sender.
+template <typename S, typename F>
+    requires (detail::sender<S>)
+[[nodiscard]]
+inline detail::let_result_sender<std::remove_cvref_t<S>, std::decay_t<F>> let_result(S&& sender, F&& f) {
+    return { std::forward<S>(sender), std::forward<F>(f) };
+}
+
+template <typename F>
+[[nodiscard]]
+inline detail::sender_closure<detail::let_result_sender, std::decay_t<F>> let_result(F&& f) {
+    return { std::forward<F>(f) };
+}
+
+/// Single threaded queue of operations, 'run()' executes them on the calling thread.
+/// Queued operations are linked through themselves, nothing is allocated.
+class run_loop {
+    struct task {
+        task* next_ = nullptr;
+        void (*execute_)(task*) noexcept = nullptr;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    task* head_ = nullptr;
+    task* tail_ = nullptr;
+    bool finishing_ = false;
+
+    inline void push(task* entry) {
+        {
+            std::lock_guard lock(mutex_);
+            entry->next_ = nullptr;
+            if (tail_ == nullptr) {
+                head_ = entry;
+            }
+            else {
+                tail_->next_ = entry;
+            }
+            tail_ = entry;
+        }
+        wake_.notify_one();
+    }
+
+    /// next task, 'nullptr' once finished and empty or once 'done' is set
+    [[nodiscard]]
+    inline task* pop(const bool* done) {
+        std::unique_lock lock(mutex_);
+        wake_.wait(lock, [this, done] { return head_ != nullptr || finishing_ || (done != nullptr && *done); });
+        if (done != nullptr && *done) {
+            return nullptr;
+        }
+        task* entry = head_;
+        if (entry != nullptr) {
+            head_ = entry->next_;
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+        }
+        return entry;
+    }
+
+public:
+    template <typename Receiver>
+    struct operation : task {
+        run_loop* loop_;
+        Receiver receiver_;
+
+        inline operation(run_loop* loop, Receiver receiver)
+            : loop_(loop), receiver_(std::move(receiver)) {
+            this->execute_ = [](task* self) noexcept {
+                std::move(static_cast<operation*>(self)->receiver_).set_value();
+            };
+        }
+
+        inline void start() noexcept {
+            loop_->push(this);
+        }
+    };
+
+    class schedule_sender {
+        run_loop* loop_;
+
+    public:
+        using sender_concept = sender_tag;
+        using value_type = void;
+        using error_type = void;
+
+        explicit inline schedule_sender(run_loop* loop) noexcept
+            : loop_(loop) {}
+
+        template <typename Receiver>
+        [[nodiscard]]
+        inline operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) && {
+            return { loop_, std::forward<Receiver>(receiver) };
+        }
+    };
+
+    class scheduler {
+        run_loop* loop_;
+
+    public:
+        explicit inline scheduler(run_loop* loop) noexcept
+            : loop_(loop) {}
+
+        [[nodiscard]]
+        inline schedule_sender schedule() const noexcept {
+            return schedule_sender(loop_);
+        }
+
+        [[nodiscard]]
+        inline bool operator==(const scheduler&) const noexcept = default;
+    };
+
+    run_loop() = default;
+    run_loop(const run_loop&) = delete;
+    run_loop& operator=(const run_loop&) = delete;
+
+    [[nodiscard]]
+    inline scheduler get_scheduler() noexcept {
+        return scheduler(this);
+    }
+
+    /// executes queued operations until 'finish()' was called and the queue is empty
+    inline void run() {
+        while (task* entry = pop(nullptr)) {
+            entry->execute_(entry);
+        }
+    }
+
+    /// Executes queued operations until 'done' was set through 'complete(done)',
+    /// operations still queued then stay for the next run.
+    inline void run_until(const bool& done) {
+        while (task* entry = pop(&done)) {
+            entry->execute_(entry);
+        }
+    }
+
+    /// sets 'done' and wakes 'run_until(done)', may be called from any thread
+    inline void complete(bool& done) {
+        // notified under the lock, 'run_until' may return and 'done' be destroyed right after
+        std::lock_guard lock(mutex_);
+        done = true;
+        wake_.notify_all();
+    }
+
+    inline void finish() {
+        // notified under the lock, 'run()' may return and the loop be destroyed right after
+        std::lock_guard lock(mutex_);
+        finishing_ = true;
+        wake_.notify_all();
+    }
+};
+
+/// Completes on a worker of a 'thread_pool'.
+class pool_scheduler {
+    thread_pool* pool_;
+
+public:
+    template <typename Receiver>
+    struct operation {
+        thread_pool* pool_;
+        Receiver receiver_;
+
+        inline void start() noexcept {
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                // a single pointer fits into the small buffer of 'std::function'
+                pool_->submit([this] {
+                    std::move(receiver_).set_value();
+                });
+#if defined(__cpp_exceptions)
+            }
+            catch (...) {
+                // the task queue could not grow
+                std::move(receiver_).set_error(std::current_exception());
+            }
+#endif
+        }
+    };
+
+    class schedule_sender {
+        thread_pool* pool_;
+
+    public:
+        using sender_concept = sender_tag;
+        using value_type = void;
+        using error_type = void;
+
+        explicit inline schedule_sender(thread_pool* pool) noexcept
+            : pool_(pool) {}
+
+        template <typename Receiver>
+        [[nodiscard]]
+        inline operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) && {
+            return { pool_, std::forward<Receiver>(receiver) };
+        }
+    };
+
+    explicit inline pool_scheduler(thread_pool& pool) noexcept
+        : pool_(&pool) {}
+
+    [[nodiscard]]
+    inline schedule_sender schedule() const noexcept {
+        return schedule_sender(pool_);
+    }
+
+    [[nodiscard]]
+    inline bool operator==(const pool_scheduler&) const noexcept = default;
+};
+
+template <typename Scheduler>
+[[nodiscard]]
+inline auto schedule(const Scheduler& scheduler) {
+    return scheduler.schedule();
+}
+
+namespace detail {
+template <typename V, typename E>
+struct sync_wait_receiver {
+    std::optional<result<V, E>>* result_;
+    std::exception_ptr* exception_;
+    run_loop* loop_;
+    bool* done_;
+
+    template <typename... Args>
+    inline void set_value(Args&&... args) && {
+        if constexpr (std::is_void_v<V>) {
+            result_->emplace();
+        }
+        else {
+            result_->emplace(std::in_place, std::forward<Args>(args)...);
+        }
+        loop_->complete(*done_);
+    }
+
+    template <typename A>
+    inline void set_error(A&& error) && {
+        result_->emplace(detail::error, convert_error<E>(std::forward<A>(error)));
+        loop_->complete(*done_);
+    }
+
+    inline void set_error(std::exception_ptr error) && {
+        *exception_ = std::move(error);
+        loop_->complete(*done_);
+    }
+};
+}
+
+/// Starts 'sender' and runs 'loop' on the calling thread until it completes, returns the value or error as result.
+/// Operations scheduled on 'loop' by the sender run here, an exception sent to 'set_error' is rethrown.
+template <typename S>
+    requires (detail::sender<S>)
+[[nodiscard]]
+inline result<detail::sender_value_t<S>, detail::sender_error_t<S>> sync_wait(run_loop& loop, S&& sender) {
+    using value_type = detail::sender_value_t<S>;
+    using error_type = detail::sender_error_t<S>;
+    static_assert(!std::is_void_v<error_type>, "'sync_wait' needs a sender which can fail, it returns a result");
+
+    std::optional<result<value_type, error_type>> res;
+    std::exception_ptr exception;
+    bool done = false;
+    auto operation = connect(std::forward<S>(sender),
+                             detail::sync_wait_receiver<value_type, error_type>{ &res, &exception, &loop, &done });
+    operation.start();
+    loop.run_until(done);
+#if defined(__cpp_exceptions)
+    if (exception) {
+        std::rethrow_exception(std::move(exception));
+    }
+#endif
+    return std::move(*res);
+}
+
+/// Starts 'sender' and blocks until it completes, returns the value or error as result.
+/// Nothing else can schedule on the loop it runs, senders have to complete inline or on another thread,
+/// use 'sync_wait(loop, sender)' for senders scheduled on a 'run_loop'.
+template <typename S>
+    requires (detail::sender<S>)
+[[nodiscard]]
+inline result<detail::sender_value_t<S>, detail::sender_error_t<S>> sync_wait(S&& sender) {
+    run_loop loop;
+    return sync_wait(loop, std::forward<S>(sender));
+}
+}
+
+#endif //RESCPP_SENDER_H
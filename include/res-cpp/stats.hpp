@@ -0,0 +1,353 @@
+// outside of the guard, 'res-cpp.hpp' includes this header with 'RESCPP_ENABLE_STATS'
+#include "res-cpp.hpp"
+
+#ifndef RESCPP_STATS_H
+#define RESCPP_STATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+// Error counters, enabled with 'RESCPP_ENABLE_STATS'.
+// Every 'fail(error)' counts a created error of its type at its call site,
+// every try macro which propagates an error counts a propagated error at the macro.
+// 'fail<E>(args...)' has no call site, it gets counted with an empty source location.
+// Counters live in a table per thread (relaxed, no contention), 'snapshot()' merges the tables of all threads.
+// Only the first 'RESCPP_STATS_CAPACITY' sites per thread get counted, later ones are reported as dropped.
+// Without 'RESCPP_ENABLE_STATS' nothing gets counted and 'fail' and the try macros are unchanged.
+//
+//   auto report = rescpp::stats::snapshot();
+//   report.merge(previous_report);
+//   report.write_json("errors.json");
+
+#ifndef RESCPP_STATS_CAPACITY
+#define RESCPP_STATS_CAPACITY 256
+#endif
+
+namespace rescpp {
+namespace stats {
+#if defined(RESCPP_ENABLE_STATS)
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+inline constexpr std::size_t capacity = RESCPP_STATS_CAPACITY;
+
+static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "'RESCPP_STATS_CAPACITY' has to be a power of two");
+
+enum class event : std::uint8_t {
+    created,
+    propagated,
+};
+
+struct site {
+    event kind;
+    std::string_view type;
+    std::source_location location;
+    std::uint64_t count;
+
+    [[nodiscard]]
+    inline bool same_site(const site& other) const noexcept {
+        return kind == other.kind
+            && type == other.type
+            && location.line() == other.location.line()
+            && location.column() == other.location.column()
+            && std::strcmp(location.file_name(), other.location.file_name()) == 0
+            && std::strcmp(location.function_name(), other.location.function_name()) == 0;
+    }
+};
+}
+
+namespace detail {
+/// the address of 'name' identifies the type
+template <typename E>
+struct stats_type {
+    static inline constexpr std::string_view name = type_name<E>();
+};
+
+inline void write_json_string(std::FILE* file, std::string_view text) {
+    std::fputc('"', file);
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            std::fprintf(file, "\\u%04x", static_cast<unsigned>(c));
+        }
+        else {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+}
+
+namespace stats {
+[[nodiscard]]
+inline constexpr std::string_view event_name(event kind) noexcept {
+    return kind == event::created ? "created" : "propagated";
+}
+
+/// Merged counters of one or more snapshots.
+class report {
+    std::vector<site> sites_;
+    std::uint64_t dropped_ = 0;
+
+public:
+    [[nodiscard]]
+    inline const std::vector<site>& sites() const noexcept {
+        return sites_;
+    }
+
+    /// events of sites which did not fit into the table of their thread
+    [[nodiscard]]
+    inline std::uint64_t dropped() const noexcept {
+        return dropped_;
+    }
+
+    /// sum of all sites of 'type'
+    [[nodiscard]]
+    inline std::uint64_t count(std::string_view type, event kind) const noexcept {
+        std::uint64_t sum = 0;
+        for (const site& entry : sites_) {
+            if (entry.kind == kind && entry.type == type) {
+                sum += entry.count;
+            }
+        }
+        return sum;
+    }
+
+    template <typename E>
+    [[nodiscard]]
+    inline std::uint64_t count(event kind) const noexcept {
+        return count(detail::stats_type<E>::name, kind);
+    }
+
+    inline void add(const site& entry) {
+        for (site& existing : sites_) {
+            if (existing.same_site(entry)) {
+                existing.count += entry.count;
+                return;
+            }
+        }
+        sites_.push_back(entry);
+    }
+
+    inline void add_dropped(std::uint64_t count) noexcept {
+        dropped_ += count;
+    }
+
+    inline void merge(const report& other) {
+        for (const site& entry : other.sites_) {
+            add(entry);
+        }
+        dropped_ += other.dropped_;
+    }
+
+    /// One site per line, most frequent first: '<count> <event> <type> <file>:<line>:<column> <function>'
+    inline bool write_text(std::FILE* file) const {
+        for (const site* entry : sorted()) {
+            std::fprintf(file, "%llu %s %.*s %s:%u:%u %s\n",
+                         static_cast<unsigned long long>(entry->count),
+                         event_name(entry->kind).data(),
+                         static_cast<int>(entry->type.size()), entry->type.data(),
+                         entry->location.file_name(),
+                         static_cast<unsigned>(entry->location.line()),
+                         static_cast<unsigned>(entry->location.column()),
+                         entry->location.function_name());
+        }
+        std::fprintf(file, "%llu dropped\n", static_cast<unsigned long long>(dropped_));
+        return std::ferror(file) == 0;
+    }
+
+    /// '{"dropped": n, "sites": [{"event", "type", "file", "line", "column", "function", "count"}, ...]}',
+    /// most frequent first
+    inline bool write_json(std::FILE* file) const {
+        std::fprintf(file, "{\"dropped\": %llu, \"sites\": [", static_cast<unsigned long long>(dropped_));
+        bool first = true;
+        for (const site* entry : sorted()) {
+            std::fputs(first ? "\n" : ",\n", file);
+            first = false;
+            std::fprintf(file, "  {\"event\": \"%s\", \"type\": ", event_name(entry->kind).data());
+            detail::write_json_string(file, entry->type);
+            std::fputs(", \"file\": ", file);
+            detail::write_json_string(file, entry->location.file_name());
+            std::fprintf(file, ", \"line\": %u, \"column\": %u, \"function\": ",
+                         static_cast<unsigned>(entry->location.line()),
+                         static_cast<unsigned>(entry->location.column()));
+            detail::write_json_string(file, entry->location.function_name());
+            std::fprintf(file, ", \"count\": %llu}", static_cast<unsigned long long>(entry->count));
+        }
+        std::fputs(first ? "]}\n" : "\n]}\n", file);
+        return std::ferror(file) == 0;
+    }
+
+    /// returns false if the file could not be written
+    inline bool write_text(const char* path) const {
+        return write_file(path, [this](std::FILE* file) { return write_text(file); });
+    }
+
+    /// returns false if the file could not be written
+    inline bool write_json(const char* path) const {
+        return write_file(path, [this](std::FILE* file) { return write_json(file); });
+    }
+
+private:
+    [[nodiscard]]
+    inline std::vector<const site*> sorted() const {
+        std::vector<const site*> entries;
+        entries.reserve(sites_.size());
+        for (const site& entry : sites_) {
+            entries.push_back(&entry);
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const site* left, const site* right) {
+            return left->count > right->count;
+        });
+        return entries;
+    }
+
+    template <typename Write>
+    static inline bool write_file(const char* path, Write&& write) {
+        std::FILE* file = std::fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+        const bool written = write(file);
+        return std::fclose(file) == 0 && written;
+    }
+};
+}
+
+namespace detail {
+struct stats_slot {
+    // set by the owning thread once the key is written
+    std::atomic<bool> used = false;
+    stats::event kind{};
+    const std::string_view* type = nullptr;
+    std::source_location location;
+    std::atomic<std::uint64_t> count = 0;
+};
+
+class stats_table;
+
+/// tables of running threads, counters of exited threads
+struct stats_registry {
+    std::mutex mutex;
+    std::vector<const stats_table*> tables;
+    stats::report exited;
+};
+
+/// Never destroyed, threads joined during static destruction (e.g. the workers of 'thread_pool::shared()')
+/// still unregister their table after the function local statics are gone.
+[[nodiscard]]
+inline stats_registry& stats_registry_instance() {
+    static auto* registry = new stats_registry;
+    return *registry;
+}
+
+/// Open addressing table, only written by its thread.
+class stats_table {
+    stats_slot slots_[stats::capacity];
+    std::atomic<std::uint64_t> dropped_ = 0;
+
+    [[nodiscard]]
+    static inline std::size_t hash(stats::event kind, const std::string_view* type,
+                                   const std::source_location& location) noexcept {
+        std::size_t value = reinterpret_cast<std::uintptr_t>(type) >> 4;
+        value = value * 31 + reinterpret_cast<std::uintptr_t>(location.file_name());
+        value = value * 31 + location.line();
+        value = value * 31 + location.column();
+        value = value * 31 + static_cast<std::size_t>(kind);
+        return value ^ (value >> 17);
+    }
+
+    // single writer, no read modify write needed
+    static inline void increment(std::atomic<std::uint64_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+public:
+    inline stats_table() {
+        stats_registry& registry = stats_registry_instance();
+        std::lock_guard lock(registry.mutex);
+        registry.tables.push_back(this);
+    }
+
+    inline ~stats_table() {
+        stats_registry& registry = stats_registry_instance();
+        std::lock_guard lock(registry.mutex);
+        add_to(registry.exited);
+        std::erase(registry.tables, this);
+    }
+
+    stats_table(const stats_table&) = delete;
+    stats_table& operator=(const stats_table&) = delete;
+
+    inline void record(stats::event kind, const std::string_view* type, const std::source_location& location) noexcept {
+        const std::size_t start = hash(kind, type, location);
+        for (std::size_t i = 0; i < stats::capacity; ++i) {
+            stats_slot& slot = slots_[(start + i) & (stats::capacity - 1)];
+            if (!slot.used.load(std::memory_order_relaxed)) {
+                slot.kind = kind;
+                slot.type = type;
+                slot.location = location;
+                slot.count.store(1, std::memory_order_relaxed);
+                slot.used.store(true, std::memory_order_release);
+                return;
+            }
+            // same literal, the file name pointer identifies the file
+            if (slot.type == type && slot.kind == kind
+                && slot.location.line() == location.line()
+                && slot.location.column() == location.column()
+                && slot.location.file_name() == location.file_name()) {
+                increment(slot.count);
+                return;
+            }
+        }
+        increment(dropped_);
+    }
+
+    inline void add_to(stats::report& report) const {
+        for (const stats_slot& slot : slots_) {
+            if (slot.used.load(std::memory_order_acquire)) {
+                report.add({ slot.kind, *slot.type, slot.location, slot.count.load(std::memory_order_relaxed) });
+            }
+        }
+        report.add_dropped(dropped_.load(std::memory_order_relaxed));
+    }
+};
+
+inline thread_local stats_table thread_stats_table;
+}
+
+namespace stats {
+/// Counts an event of error type 'E' at 'location' on this thread.
+template <typename E>
+inline void record(event kind, const std::source_location& location) noexcept {
+    detail::thread_stats_table.record(kind, &detail::stats_type<E>::name, location);
+}
+
+/// Counters of all threads, including the ones which already exited.
+[[nodiscard]]
+inline report snapshot() {
+    detail::stats_registry& registry = detail::stats_registry_instance();
+    std::lock_guard lock(registry.mutex);
+    report merged = registry.exited;
+    for (const detail::stats_table* table : registry.tables) {
+        table->add_to(merged);
+    }
+    return merged;
+}
+}
+}
+
+#endif //RESCPP_STATS_H
@@ -0,0 +1,104 @@
+#ifndef RESCPP_TRACE_H
+#define RESCPP_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+
+// Propagation trace, enabled with 'RESCPP_ENABLE_TRACE'.
+// Every error created with 'fail(...)' gets an id, which 'failure' and 'result' carry along with the error
+// through the try macros, 'co_await', conversions and the combinators. Every try macro and 'co_await' which
+// propagates an error records its source location as hop of that id into a thread local ring buffer,
+// so errors propagated interleaved keep their own hops.
+// Only the last 'RESCPP_TRACE_CAPACITY' hops of a thread are kept.
+// Without 'RESCPP_ENABLE_TRACE' nothing gets recorded, no id is stored and the layout of 'result' stays the same.
+//
+// Limits:
+// - hops go to the buffer of the propagating thread, 'for_each_hop' only sees the ones of the calling thread
+// - errors constructed without 'fail' ('failure', 'emplace_error', ...) have id '0'
+// - errors passed through other channels (a sender's 'set_error', 'parallel_transform', ...) lose their id
+//
+//   auto res = load_config();
+//   if (res.has_error()) {
+//       rescpp::trace::for_each_hop(rescpp::trace::error_id(res), [](const rescpp::trace::hop& hop) {
+//           std::printf("%s:%u\n", hop.location.file_name(), hop.location.line());
+//       });
+//   }
+
+#ifndef RESCPP_TRACE_CAPACITY
+#define RESCPP_TRACE_CAPACITY 64
+#endif
+
+namespace rescpp {
+namespace trace {
+#if defined(RESCPP_ENABLE_TRACE)
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+inline constexpr std::size_t capacity = RESCPP_TRACE_CAPACITY;
+
+static_assert(capacity > 0, "'RESCPP_TRACE_CAPACITY' has to be at least 1");
+
+struct hop {
+    std::uint64_t error;
+    std::source_location location;
+};
+}
+
+namespace detail {
+/// threads which created a trace buffer, the index goes into the upper bits of their error ids
+inline std::atomic<std::uint64_t> trace_thread_count = 0;
+
+inline constexpr int trace_thread_shift = 40;
+
+struct trace_buffer {
+    trace::hop hops[trace::capacity];
+    std::uint64_t hop_count = 0;
+    std::uint64_t current_error = (trace_thread_count.fetch_add(1, std::memory_order_relaxed) + 1) << trace_thread_shift;
+};
+
+inline thread_local trace_buffer thread_trace_buffer;
+}
+
+namespace trace {
+/// Returns the id of a new error, unique across threads.
+inline std::uint64_t begin_error() noexcept {
+    return ++detail::thread_trace_buffer.current_error;
+}
+
+inline void record_hop(std::uint64_t error, std::source_location location) noexcept {
+    auto& buffer = detail::thread_trace_buffer;
+    buffer.hops[buffer.hop_count % capacity] = hop{ error, location };
+    ++buffer.hop_count;
+}
+
+/// id of the last error created on this thread, use 'error_id(result)' for the one of a result
+[[nodiscard]]
+inline std::uint64_t current_error() noexcept {
+    return detail::thread_trace_buffer.current_error;
+}
+
+/// Calls 'f' with every recorded hop of 'error', oldest first.
+template <typename F>
+inline void for_each_hop(std::uint64_t error, F&& f) {
+    const auto& buffer = detail::thread_trace_buffer;
+    const std::uint64_t first = buffer.hop_count > capacity ? buffer.hop_count - capacity : 0;
+    for (std::uint64_t i = first; i < buffer.hop_count; ++i) {
+        const hop& entry = buffer.hops[i % capacity];
+        if (entry.error == error) {
+            f(entry);
+        }
+    }
+}
+
+/// Drops every recorded hop of this thread.
+inline void clear() noexcept {
+    detail::thread_trace_buffer.hop_count = 0;
+}
+}
+}
+
+#endif //RESCPP_TRACE_H
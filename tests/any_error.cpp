@@ -0,0 +1,142 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/any_error.hpp>
+
+enum class FileError : std::uint16_t {
+    not_found = 1,
+    denied,
+};
+
+template <>
+struct rescpp::code_category<FileError> {
+    static constexpr std::uint8_t id = 3;
+    static constexpr std::string_view name = "io";
+
+    static constexpr std::string_view message(FileError error) noexcept {
+        return error == FileError::not_found ? "not found" : "denied";
+    }
+};
+
+struct SyntaxError {
+    int line;
+    std::string message;
+
+    bool operator==(const SyntaxError& other) const = default;
+};
+
+struct Timeout {
+    std::int64_t milliseconds;
+
+    bool operator==(const Timeout& other) const = default;
+};
+
+template <>
+struct rescpp::any_error_traits<Timeout> {
+    static constexpr std::string_view category = "net";
+
+    static std::string_view message(const Timeout&) noexcept {
+        return "timed out";
+    }
+};
+
+// no 'operator==', no message
+struct Opaque {
+    int value;
+};
+
+static_assert(sizeof(rescpp::any_error) == 32);
+static_assert(rescpp::any_error::stored_inline<FileError>);
+static_assert(rescpp::any_error::stored_inline<Timeout>);
+static_assert(!rescpp::any_error::stored_inline<SyntaxError>);
+
+static rescpp::result<int, FileError> open_file(bool exists) {
+    if (!exists) {
+        return rescpp::fail(FileError::not_found);
+    }
+    return 3;
+}
+
+static rescpp::result<int, SyntaxError> parse(int fd) {
+    if (fd < 0) {
+        return rescpp::fail(SyntaxError{ 4, "unexpected end" });
+    }
+    return fd * 2;
+}
+
+static rescpp::result<int, rescpp::any_error> load(bool exists, int offset) {
+    auto fd = RESCPP_TRY(open_file(exists));
+    auto value = RESCPP_TRY(parse(fd + offset));
+    return value;
+}
+
+TEST_CASE("any_error", "[any_error]") {
+    SECTION("Propagation without type_converter") {
+        REQUIRE(load(true, 0).value() == 6);
+
+        auto missing = load(false, 0);
+        REQUIRE(missing.error().is<FileError>());
+        REQUIRE_FALSE(missing.error().is<SyntaxError>());
+        REQUIRE(missing.error().as<FileError>() == FileError::not_found);
+
+        auto invalid = load(true, -10);
+        REQUIRE(invalid.error().is<SyntaxError>());
+        REQUIRE(invalid.error().as<SyntaxError>().line == 4);
+    }
+
+    SECTION("Category and message") {
+        const rescpp::any_error io(FileError::denied);
+        REQUIRE(io.category() == "io");
+        REQUIRE(io.message() == "denied");
+
+        const rescpp::any_error parse_error(SyntaxError{ 1, "bad token" });
+        REQUIRE(parse_error.category() == "SyntaxError");
+        REQUIRE(parse_error.message() == "bad token");
+
+        const rescpp::any_error timeout(Timeout{ 100 });
+        REQUIRE(timeout.category() == "net");
+        REQUIRE(timeout.message() == "timed out");
+
+        const rescpp::any_error opaque(Opaque{ 1 });
+        REQUIRE(opaque.category() == "Opaque");
+        REQUIRE(opaque.message().empty());
+    }
+
+    SECTION("Equality") {
+        const rescpp::any_error first(Timeout{ 1 });
+        REQUIRE(first == rescpp::any_error(Timeout{ 1 }));
+        REQUIRE_FALSE(first == rescpp::any_error(Timeout{ 2 }));
+        REQUIRE_FALSE(first == rescpp::any_error(FileError::not_found));
+
+        const rescpp::any_error opaque(Opaque{ 1 });
+        REQUIRE_FALSE(opaque == opaque);
+    }
+
+    SECTION("Copy and move") {
+        rescpp::any_error inline_error(std::in_place_type<Timeout>, 5);
+        rescpp::any_error heap_error(SyntaxError{ 2, "a message long enough to leave the small buffer" });
+
+        auto copy = heap_error;
+        REQUIRE(copy == heap_error);
+        REQUIRE(&copy.as<SyntaxError>() != &heap_error.as<SyntaxError>());
+
+        auto moved = std::move(heap_error);
+        REQUIRE(moved.as<SyntaxError>().line == 2);
+        REQUIRE(heap_error.empty());
+        REQUIRE(heap_error.category().empty());
+
+        heap_error = inline_error;
+        REQUIRE(heap_error.as<Timeout>().milliseconds == 5);
+        inline_error = std::move(moved);
+        REQUIRE(inline_error.is<SyntaxError>());
+        REQUIRE(inline_error.message() == "a message long enough to leave the small buffer");
+    }
+
+    SECTION("Void result") {
+        rescpp::result<void, rescpp::any_error> res = rescpp::fail(Timeout{ 3 });
+        REQUIRE(res.has_error());
+        REQUIRE(res.error().as<Timeout>().milliseconds == 3);
+    }
+}
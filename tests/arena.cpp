@@ -0,0 +1,102 @@
+#include <memory_resource>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/arena.hpp>
+
+struct PmrError {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    int code;
+    std::pmr::string message;
+
+    PmrError(int error_code, std::string_view text, const allocator_type& alloc = {})
+        : code(error_code), message(text, alloc) {}
+
+    PmrError(PmrError&& other, const allocator_type& alloc)
+        : code(other.code), message(std::move(other.message), alloc) {}
+
+    PmrError(PmrError&&) noexcept = default;
+};
+
+// counts the allocations going to the upstream resource
+struct CountingResource final : std::pmr::memory_resource {
+    int allocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+static const char* const long_text = "an error message long enough to not fit into the small string buffer";
+
+static rescpp::result<int, PmrError> failing(rescpp::request_arena<>& arena) {
+    return rescpp::fail<PmrError>(std::allocator_arg, arena.allocator(), 1, long_text);
+}
+
+static rescpp::result<int, PmrError> forward(rescpp::request_arena<>& arena) {
+    auto value = RESCPP_TRY(failing(arena));
+    return value;
+}
+
+TEST_CASE("Allocator aware construction", "[arena]") {
+    CountingResource upstream;
+    std::pmr::polymorphic_allocator<> alloc(&upstream);
+
+    SECTION("fail") {
+        rescpp::result<int, PmrError> res = rescpp::fail<PmrError>(std::allocator_arg, alloc, 2, long_text);
+
+        REQUIRE(res.error().code == 2);
+        REQUIRE(res.error().message == long_text);
+        REQUIRE(res.error().message.get_allocator().resource() == &upstream);
+        REQUIRE(upstream.allocations == 1);
+    }
+
+    SECTION("in_place value") {
+        rescpp::result<std::pmr::string, int> res(std::allocator_arg, alloc, std::in_place, long_text);
+
+        REQUIRE(res.value() == long_text);
+        REQUIRE(res.value().get_allocator().resource() == &upstream);
+        REQUIRE(upstream.allocations == 1);
+    }
+}
+
+TEST_CASE("Request arena", "[arena]") {
+    CountingResource upstream;
+    rescpp::request_arena<> arena(&upstream);
+
+    SECTION("Errors come from the inline buffer") {
+        auto res = forward(arena);
+
+        REQUIRE(res.error().message == long_text);
+        REQUIRE(res.error().message.get_allocator().resource() == arena.resource());
+        REQUIRE(upstream.allocations == 0);
+    }
+
+    SECTION("Release reuses the buffer") {
+        for (int i = 0; i < 1000; ++i) {
+            {
+                auto res = forward(arena);
+                REQUIRE(res.has_error());
+            }
+            arena.release();
+        }
+        REQUIRE(upstream.allocations == 0);
+    }
+
+    SECTION("Upstream once the buffer is used up") {
+        for (int i = 0; i < 100; ++i) {
+            static_cast<void>(forward(arena));
+        }
+        REQUIRE(upstream.allocations > 0);
+    }
+}
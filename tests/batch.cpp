@@ -0,0 +1,131 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/batch.hpp>
+#include <res-cpp/result_vector.hpp>
+
+enum class Lane : std::uint8_t {
+    none,
+    used,
+};
+
+template <>
+struct rescpp::niche_traits<Lane> : rescpp::sentinel_niche<Lane, Lane::none> {};
+
+struct LaneMissing {};
+
+static constexpr rescpp::batch_isa all_isas[] = {
+    rescpp::batch_isa::scalar,
+    rescpp::batch_isa::sse2,
+    rescpp::batch_isa::avx2,
+};
+
+// sizes around the block sizes of the kernels, every 'error_every'th result is an error
+template <typename R, typename MakeValue, typename MakeError>
+static void check_batch(MakeValue make_value, MakeError make_error) {
+    for (const std::size_t size : { 0, 1, 7, 8, 9, 16, 17, 31, 32, 33, 100, 257 }) {
+        for (const std::size_t error_every : { 1, 5, 64, 1000 }) {
+            std::vector<R> results;
+            std::vector<decltype(make_value(0))> expected_values;
+            std::size_t expected_count = 0;
+            std::size_t expected_first = rescpp::no_error_index;
+            for (std::size_t i = 0; i < size; ++i) {
+                if (i % error_every == error_every - 1) {
+                    results.push_back(make_error(i));
+                    ++expected_count;
+                    if (expected_first == rescpp::no_error_index) {
+                        expected_first = i;
+                    }
+                }
+                else {
+                    results.push_back(make_value(i));
+                    expected_values.push_back(make_value(i));
+                }
+            }
+
+            for (const auto isa : all_isas) {
+                INFO("size " << size << ", error every " << error_every << ", isa " << static_cast<int>(isa));
+
+                REQUIRE(rescpp::count_errors(results, isa) == expected_count);
+                REQUIRE(rescpp::any_error(results, isa) == (expected_count != 0));
+                REQUIRE(rescpp::all_ok(results, isa) == (expected_count == 0));
+                REQUIRE(rescpp::first_error_index(results, isa) == expected_first);
+
+                std::vector<decltype(make_value(0))> values(size);
+                values.resize(rescpp::compact_values(results, values.data(), isa));
+                REQUIRE(values == expected_values);
+            }
+        }
+    }
+}
+
+TEST_CASE("Batch status of result arrays", "[batch]") {
+    SECTION("Strides dividing the block size") {
+        check_batch<rescpp::result<int, int>>([](std::size_t i) { return static_cast<int>(i); },
+                                               [](std::size_t i) { return rescpp::fail(static_cast<int>(i)); });
+        check_batch<rescpp::result<char, char>>([](std::size_t i) { return static_cast<char>(i % 100); },
+                                                 [](std::size_t) { return rescpp::fail('e'); });
+        check_batch<rescpp::result<double, char>>([](std::size_t i) { return static_cast<double>(i); },
+                                                   [](std::size_t) { return rescpp::fail('e'); });
+    }
+
+    SECTION("Gathered strides") {
+        check_batch<rescpp::result<std::string, int>>([](std::size_t i) { return std::to_string(i); },
+                                                       [](std::size_t i) { return rescpp::fail(static_cast<int>(i)); });
+        // 3 bytes per result
+        check_batch<rescpp::result<std::array<char, 2>, char>>([](std::size_t i) { return std::array<char, 2>{ 'v', static_cast<char>(i % 100) }; },
+                                                                [](std::size_t) { return rescpp::fail('e'); });
+    }
+
+    SECTION("Niche results") {
+        static_assert(!rescpp::detail::result_layout<rescpp::result<Lane, LaneMissing>>::has_error_flag);
+        check_batch<rescpp::result<Lane, LaneMissing>>([](std::size_t) { return Lane::used; },
+                                                        [](std::size_t) { return rescpp::fail(LaneMissing{}); });
+    }
+
+    SECTION("Error flag position") {
+        using layout = rescpp::detail::result_layout<rescpp::result<int, int>>;
+        STATIC_REQUIRE(layout::has_error_flag);
+        STATIC_REQUIRE(layout::error_flag_offset == sizeof(int));
+    }
+}
+
+TEST_CASE("Batch status of error bitmaps", "[batch]") {
+    SECTION("Result vector") {
+        rescpp::result_vector<int, int> batch;
+        for (int i = 0; i < 300; ++i) {
+            if (i == 130 || i == 131 || i == 299) {
+                batch.push_back(rescpp::fail(i));
+            }
+            else {
+                batch.push_back(i);
+            }
+        }
+
+        for (const auto isa : all_isas) {
+            REQUIRE(rescpp::count_errors(batch.error_bits(), isa) == 3);
+            REQUIRE(rescpp::any_error(batch.error_bits(), isa));
+            REQUIRE_FALSE(rescpp::all_ok(batch.error_bits(), isa));
+            REQUIRE(rescpp::first_error_index(batch.error_bits(), isa) == 130);
+
+            std::vector<int> values(batch.size());
+            values.resize(rescpp::compact_values(batch.value_slots(), batch.error_bits(), values.data(), isa));
+            REQUIRE(values.size() == 297);
+            REQUIRE(values[129] == 129);
+            REQUIRE(values[130] == 132);
+            REQUIRE(values.back() == 298);
+        }
+    }
+
+    SECTION("Without errors") {
+        const std::vector<std::uint64_t> bits(9, 0);
+        for (const auto isa : all_isas) {
+            REQUIRE(rescpp::all_ok(bits, isa));
+            REQUIRE(rescpp::count_errors(bits, isa) == 0);
+            REQUIRE(rescpp::first_error_index(bits, isa) == rescpp::no_error_index);
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/channel.hpp>
+
+enum class StreamError {
+    corrupt,
+    end_of_stream,
+};
+
+struct Frame {
+    int width;
+    int height;
+
+    Frame(int frame_width, int frame_height)
+        : width(frame_width), height(frame_height) {}
+};
+
+// constructor may throw, moving it can not
+struct CheckedFrame {
+    int width;
+
+    explicit CheckedFrame(int frame_width)
+        : width(frame_width) {
+        if (frame_width < 0) {
+            throw std::invalid_argument("negative width");
+        }
+    }
+
+    CheckedFrame(CheckedFrame&&) noexcept = default;
+};
+
+TEMPLATE_TEST_CASE_SIG("Result channel", "[channel]", ((rescpp::channel_mode Mode), Mode),
+                       rescpp::channel_mode::spsc, rescpp::channel_mode::mpmc) {
+    SECTION("Values and errors in order") {
+        rescpp::result_channel<Frame, StreamError, Mode> channel(4);
+
+        REQUIRE(channel.capacity() == 4);
+        REQUIRE(channel.try_push(std::in_place, 640, 480) == rescpp::channel_state::ok);
+        REQUIRE(channel.try_push(rescpp::fail(StreamError::corrupt)) == rescpp::channel_state::ok);
+        REQUIRE(channel.try_push(Frame(1, 2)) == rescpp::channel_state::ok);
+
+        auto first = channel.try_pop();
+        REQUIRE(first.has_value());
+        REQUIRE(first->value().width == 640);
+        REQUIRE(channel.try_pop()->error() == StreamError::corrupt);
+        REQUIRE(channel.pop().value().height == 2);
+        REQUIRE_FALSE(channel.try_pop().has_value());
+    }
+
+    SECTION("Full") {
+        rescpp::result_channel<int, StreamError, Mode> channel(2);
+
+        REQUIRE(channel.try_push(1) == rescpp::channel_state::ok);
+        REQUIRE(channel.try_push(2) == rescpp::channel_state::ok);
+        REQUIRE(channel.try_push(3) == rescpp::channel_state::full);
+        REQUIRE(channel.pop().value() == 1);
+        REQUIRE(channel.try_push(3) == rescpp::channel_state::ok);
+    }
+
+    SECTION("Close with error") {
+        rescpp::result_channel<std::string, StreamError, Mode> channel(8);
+
+        REQUIRE(channel.push(std::in_place, "last"));
+        REQUIRE(channel.close(StreamError::end_of_stream));
+        REQUIRE_FALSE(channel.close(StreamError::corrupt));
+        REQUIRE(channel.is_closed());
+        REQUIRE(channel.try_push("late") == rescpp::channel_state::closed);
+        REQUIRE_FALSE(channel.push("late"));
+
+        // remaining results first, then the close error on every pop
+        REQUIRE(channel.pop().value() == "last");
+        REQUIRE(channel.pop().error() == StreamError::end_of_stream);
+        REQUIRE(channel.try_pop()->error() == StreamError::end_of_stream);
+    }
+
+    SECTION("Throwing constructor leaves the channel usable") {
+        rescpp::result_channel<CheckedFrame, StreamError, Mode> channel(2);
+
+        REQUIRE_THROWS_AS(channel.try_push(std::in_place, -1), std::invalid_argument);
+        REQUIRE(channel.try_push(std::in_place, 3) == rescpp::channel_state::ok);
+        REQUIRE_FALSE(channel.try_pop()->has_error());
+        REQUIRE_FALSE(channel.try_pop().has_value());
+    }
+
+    SECTION("Remaining results are destroyed with the channel") {
+        auto shared = std::make_shared<int>(1);
+        {
+            rescpp::result_channel<std::shared_ptr<int>, StreamError, Mode> channel(4);
+            channel.push(shared);
+            channel.push(shared);
+            REQUIRE(shared.use_count() == 3);
+        }
+        REQUIRE(shared.use_count() == 1);
+    }
+}
+
+TEST_CASE("Result channel between threads", "[channel]") {
+    constexpr int count = 20000;
+
+    SECTION("Single producer and consumer") {
+        rescpp::spsc_result_channel<int, StreamError> channel(64);
+        std::thread producer([&channel] {
+            for (int i = 0; i < count; ++i) {
+                channel.push(i);
+            }
+            channel.close(StreamError::end_of_stream);
+        });
+
+        long long sum = 0;
+        int expected = 0;
+        bool ordered = true;
+        for (auto res = channel.pop(); !res.has_error(); res = channel.pop()) {
+            ordered = ordered && res.value() == expected++;
+            sum += res.value();
+        }
+        producer.join();
+
+        REQUIRE(ordered);
+        REQUIRE(sum == static_cast<long long>(count) * (count - 1) / 2);
+    }
+
+    SECTION("Many producers and consumers") {
+        rescpp::result_channel<int, StreamError> channel(64);
+        std::atomic<int> producers_left = 4;
+        std::atomic<long long> sum = 0;
+        std::atomic<int> terminal_errors = 0;
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < 4; ++p) {
+            threads.emplace_back([&, p] {
+                for (int i = p; i < count; i += 4) {
+                    channel.push(i);
+                }
+                if (--producers_left == 0) {
+                    channel.close(StreamError::end_of_stream);
+                }
+            });
+        }
+        for (int c = 0; c < 3; ++c) {
+            threads.emplace_back([&] {
+                auto res = channel.pop();
+                for (; !res.has_error(); res = channel.pop()) {
+                    sum += res.value();
+                }
+                if (res.error() == StreamError::end_of_stream) {
+                    ++terminal_errors;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        REQUIRE(sum == static_cast<long long>(count) * (count - 1) / 2);
+        REQUIRE(terminal_errors == 3);
+    }
+}
@@ -0,0 +1,118 @@
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/code.hpp>
+
+enum class IoError : std::uint16_t {
+    not_found = 1,
+    denied,
+};
+
+enum class ParseError {
+    eof = -1,
+    invalid = 1,
+    // largest value which fits into a code
+    overflow = (1 << 23) - 1,
+};
+
+template <>
+struct rescpp::code_category<IoError> {
+    static constexpr std::uint8_t id = 1;
+    static constexpr std::string_view name = "io";
+
+    static constexpr std::string_view message(IoError error) noexcept {
+        return error == IoError::not_found ? "not found" : "denied";
+    }
+};
+
+template <>
+struct rescpp::code_category<ParseError> {
+    static constexpr std::uint8_t id = 2;
+    static constexpr std::string_view name = "parse";
+
+    static constexpr std::string_view message(ParseError error) noexcept {
+        return error == ParseError::eof ? "end of file" : "invalid";
+    }
+};
+
+static_assert(sizeof(rescpp::code) == 4);
+static_assert(sizeof(rescpp::result<void, rescpp::code>) == sizeof(rescpp::code));
+static_assert(sizeof(rescpp::result<int, rescpp::code>) == 2 * sizeof(int));
+static_assert(std::is_trivially_copyable_v<rescpp::result<int, rescpp::code>>);
+
+static rescpp::result<int, IoError> open_file(bool exists) {
+    if (!exists) {
+        return rescpp::fail(IoError::not_found);
+    }
+    return 3;
+}
+
+static rescpp::result<int, ParseError> parse(int fd) {
+    if (fd < 0) {
+        return rescpp::fail(ParseError::invalid);
+    }
+    return fd * 2;
+}
+
+static rescpp::result<int, rescpp::code> load(bool exists, int offset) {
+    auto fd = RESCPP_TRY(open_file(exists));
+    auto value = RESCPP_TRY(parse(fd + offset));
+    return value;
+}
+
+static rescpp::result<void, rescpp::code> check(bool denied) {
+    if (denied) {
+        return rescpp::fail(IoError::denied);
+    }
+    return {};
+}
+
+TEST_CASE("Code", "[code]") {
+    SECTION("Category and value") {
+        constexpr rescpp::code code = IoError::denied;
+
+        STATIC_REQUIRE(code.category() == 1);
+        STATIC_REQUIRE(code.value() == 2);
+        STATIC_REQUIRE(code.is<IoError>());
+        STATIC_REQUIRE_FALSE(code.is<ParseError>());
+        STATIC_REQUIRE(code.as<IoError>() == IoError::denied);
+        STATIC_REQUIRE(code == IoError::denied);
+        STATIC_REQUIRE(code != rescpp::code(IoError::not_found));
+    }
+
+    SECTION("Negative values") {
+        constexpr rescpp::code eof = ParseError::eof;
+
+        STATIC_REQUIRE(eof.as<ParseError>() == ParseError::eof);
+        STATIC_REQUIRE(eof.value() == rescpp::code::value_mask);
+        STATIC_REQUIRE(rescpp::code(ParseError::overflow).as<ParseError>() == ParseError::overflow);
+        STATIC_REQUIRE_FALSE(rescpp::detail::code_value_fits(static_cast<ParseError>(1 << 23)));
+        STATIC_REQUIRE_FALSE(rescpp::detail::code_value_fits(static_cast<ParseError>(-(1 << 23) - 1)));
+        REQUIRE(eof.message() == "end of file");
+    }
+
+    SECTION("Message lookup") {
+        const rescpp::code code = IoError::not_found;
+
+        REQUIRE(code.category_name() == "io");
+        REQUIRE(code.message() == "not found");
+        REQUIRE(rescpp::code(ParseError::invalid).message() == "invalid");
+    }
+
+    SECTION("Converted from layer errors") {
+        REQUIRE(load(true, 0).value() == 6);
+
+        auto missing = load(false, 0);
+        REQUIRE(missing.error() == IoError::not_found);
+        REQUIRE(missing.error().category_name() == "io");
+
+        auto invalid = load(true, -10);
+        REQUIRE(invalid.error() == ParseError::invalid);
+        REQUIRE(invalid.error().message() == "invalid");
+    }
+
+    SECTION("Void result uses niche") {
+        REQUIRE_FALSE(check(false).has_error());
+        REQUIRE(check(true).error() == IoError::denied);
+    }
+}
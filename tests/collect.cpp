@@ -0,0 +1,133 @@
+#include <list>
+#include <ranges>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/collect.hpp>
+
+enum class ItemError {
+    negative,
+};
+
+static rescpp::result<int, ItemError> validate(int value) {
+    if (value < 0) {
+        return rescpp::fail(ItemError::negative);
+    }
+    return value;
+}
+
+// Counts copies, collecting should only move
+struct Tracked {
+    int value;
+    int* copies;
+
+    Tracked(int val, int* copy_count)
+        : value(val), copies(copy_count) {}
+
+    Tracked(const Tracked& other)
+        : value(other.value), copies(other.copies) {
+        ++*copies;
+    }
+
+    Tracked(Tracked&&) noexcept = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+};
+
+TEST_CASE("Collect", "[collect]") {
+    SECTION("All values") {
+        const std::vector<int> input{ 1, 2, 3 };
+        auto res = rescpp::collect(input | std::views::transform(validate));
+
+        REQUIRE(res.value() == std::vector<int>{ 1, 2, 3 });
+    }
+
+    SECTION("Stops at the first error") {
+        int calls = 0;
+        const std::vector<int> input{ 1, -1, 2, -2 };
+        auto res = rescpp::collect(input | std::views::transform([&calls](int value) {
+            ++calls;
+            return validate(value);
+        }));
+
+        REQUIRE(res.error() == ItemError::negative);
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("Values of rvalue results are moved") {
+        int copies = 0;
+        std::vector<rescpp::result<Tracked, ItemError>> input;
+        input.emplace_back(std::in_place, 1, &copies);
+        input.emplace_back(std::in_place, 2, &copies);
+
+        auto res = rescpp::collect(std::move(input));
+
+        REQUIRE(res.value().size() == 2);
+        REQUIRE(res.value()[1].value == 2);
+        REQUIRE(copies == 0);
+    }
+
+    SECTION("Lvalue ranges are copied") {
+        int copies = 0;
+        std::vector<rescpp::result<Tracked, ItemError>> input;
+        input.emplace_back(std::in_place, 1, &copies);
+
+        auto res = rescpp::collect(input);
+
+        REQUIRE(res.value().size() == 1);
+        REQUIRE(copies == 1);
+        REQUIRE(input.front().value().value == 1);
+    }
+
+    SECTION("Views and borrowed ranges are copied") {
+        std::vector<rescpp::result<std::string, ItemError>> input;
+        input.emplace_back(std::in_place, "first");
+        input.emplace_back(std::in_place, "second");
+        input.emplace_back(std::in_place, "third");
+
+        auto spanned = rescpp::collect(std::span(input));
+        REQUIRE(spanned.value() == std::vector<std::string>{ "first", "second", "third" });
+
+        auto taken = rescpp::collect(input | std::views::take(2));
+        REQUIRE(taken.value() == std::vector<std::string>{ "first", "second" });
+
+        auto all = rescpp::collect(std::views::all(input));
+        REQUIRE(all.value().size() == 3);
+
+        REQUIRE(input[0].value() == "first");
+        REQUIRE(input[1].value() == "second");
+        REQUIRE(input[2].value() == "third");
+    }
+
+    SECTION("Void results") {
+        const std::vector<rescpp::result<void, ItemError>> good(3);
+        REQUIRE_FALSE(rescpp::collect(good).has_error());
+
+        std::vector<rescpp::result<void, ItemError>> bad(3);
+        bad[1] = rescpp::fail(ItemError::negative);
+        REQUIRE(rescpp::collect(bad).error() == ItemError::negative);
+    }
+}
+
+TEST_CASE("Collect into", "[collect]") {
+    const std::list<int> input{ 3, 1, 2, 1 };
+
+    auto set = rescpp::collect_into<std::set<int>>(input | std::views::transform(validate));
+    REQUIRE(set.value() == std::set<int>{ 1, 2, 3 });
+
+    auto strings = rescpp::collect_into<std::vector<std::string>>(
+        input | std::views::transform([](int value) -> rescpp::result<std::string, ItemError> {
+            return std::string(static_cast<std::size_t>(value), 'x');
+        }));
+    REQUIRE(strings.value().back() == "x");
+}
+
+TEST_CASE("Partition", "[collect]") {
+    const std::vector<int> input{ 1, -1, 2, -2, 3 };
+    auto parts = rescpp::partition(input | std::views::transform(validate));
+
+    REQUIRE(parts.values == std::vector<int>{ 1, 2, 3 });
+    REQUIRE(parts.errors.size() == 2);
+}
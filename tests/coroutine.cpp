@@ -0,0 +1,200 @@
+#include <memory>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/coroutine.hpp>
+
+enum class CoroutineError {
+    negative,
+    too_big,
+};
+
+struct LayerError {
+    std::string message;
+};
+
+template <>
+struct rescpp::type_converter<CoroutineError, LayerError> {
+    static LayerError convert(const CoroutineError& error) noexcept {
+        return LayerError{ error == CoroutineError::negative ? "negative" : "too big" };
+    }
+};
+
+static rescpp::result<int, CoroutineError> check_positive(int value) {
+    if (value < 0) {
+        return rescpp::fail(CoroutineError::negative);
+    }
+    return value;
+}
+
+static rescpp::result<void, CoroutineError> check_small(int value) {
+    if (value > 100) {
+        return rescpp::fail(CoroutineError::too_big);
+    }
+    return {};
+}
+
+static rescpp::result<int, CoroutineError> double_checked(int value) {
+    auto checked = co_await check_positive(value);
+    co_await check_small(checked);
+    co_return checked * 2;
+}
+
+static rescpp::result<int, LayerError> converted_layer(int value) {
+    auto doubled = co_await double_checked(value);
+    co_return doubled + 1;
+}
+
+static rescpp::result<int, CoroutineError> explicit_failure(bool fail) {
+    if (fail) {
+        co_return rescpp::fail(CoroutineError::too_big);
+    }
+    co_return 1;
+}
+
+// 'result<void, E>' coroutines end with 'co_return {};'
+static rescpp::result<void, CoroutineError> void_coroutine(int value) {
+    co_await check_positive(value);
+    co_await check_small(value);
+    co_return {};
+}
+
+TEST_CASE("Coroutine result", "[coroutine]") {
+    SECTION("Success path") {
+        auto res = double_checked(21);
+
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(res.value() == 42);
+    }
+
+    SECTION("Error from value result") {
+        auto res = double_checked(-1);
+
+        REQUIRE(res.has_error());
+        REQUIRE(res.error() == CoroutineError::negative);
+    }
+
+    SECTION("Error from void result") {
+        auto res = double_checked(101);
+
+        REQUIRE(res.has_error());
+        REQUIRE(res.error() == CoroutineError::too_big);
+    }
+
+    SECTION("Error converted through type_converter") {
+        auto res = converted_layer(-1);
+
+        REQUIRE(res.has_error());
+        REQUIRE(res.error().message == "negative");
+
+        auto good = converted_layer(1);
+        REQUIRE(good.value() == 3);
+    }
+
+    SECTION("Void coroutine") {
+        REQUIRE_FALSE(void_coroutine(1).has_error());
+        REQUIRE(void_coroutine(-1).error() == CoroutineError::negative);
+        REQUIRE(void_coroutine(101).error() == CoroutineError::too_big);
+    }
+
+    SECTION("co_return failure") {
+        REQUIRE(explicit_failure(true).has_error());
+        REQUIRE(explicit_failure(false).value() == 1);
+    }
+
+    SECTION("co_await lvalue result does not move from it") {
+        auto source = []() -> rescpp::result<std::string, LayerError> {
+            return rescpp::fail(LayerError{ "kept" });
+        };
+        auto coroutine = [](const rescpp::result<std::string, LayerError>& res) -> rescpp::result<int, LayerError> {
+            auto value = co_await res;
+            co_return static_cast<int>(value.size());
+        };
+
+        const auto res = source();
+        auto awaited = coroutine(res);
+
+        REQUIRE(awaited.has_error());
+        REQUIRE(awaited.error().message == "kept");
+        REQUIRE(res.error().message == "kept");
+    }
+}
+
+// Destructor counting local, checks that the frame gets cleaned up on the error path
+struct Guard {
+    int* destroyed;
+
+    explicit Guard(int* counter)
+        : destroyed(counter) {}
+
+    Guard(const Guard&) = delete;
+
+    ~Guard() {
+        ++*destroyed;
+    }
+};
+
+static rescpp::result<int, CoroutineError> guarded(int* destroyed, int value) {
+    Guard guard(destroyed);
+    auto checked = co_await check_positive(value);
+    co_return checked;
+}
+
+TEST_CASE("Coroutine destroys locals on error", "[coroutine]") {
+    int destroyed = 0;
+
+    auto res = guarded(&destroyed, -1);
+    REQUIRE(res.has_error());
+    REQUIRE(destroyed == 1);
+
+    auto good = guarded(&destroyed, 1);
+    REQUIRE_FALSE(good.has_error());
+    REQUIRE(destroyed == 2);
+}
+
+// Allocator counting the allocated frames
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    int* allocations;
+    int* deallocations;
+
+    template <typename U>
+    explicit CountingAllocator(const CountingAllocator<U>& other) noexcept
+        : allocations(other.allocations), deallocations(other.deallocations) {}
+
+    CountingAllocator(int* allocs, int* deallocs) noexcept
+        : allocations(allocs), deallocations(deallocs) {}
+
+    T* allocate(std::size_t count) {
+        ++*allocations;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept {
+        ++*deallocations;
+        std::allocator<T>().deallocate(ptr, count);
+    }
+};
+
+static rescpp::result<int, CoroutineError> allocated(std::allocator_arg_t, const CountingAllocator<int>&, int value) {
+    auto checked = co_await check_positive(value);
+    co_return checked + 1;
+}
+
+TEST_CASE("Coroutine frame allocator", "[coroutine]") {
+    int allocations = 0;
+    int deallocations = 0;
+    const CountingAllocator<int> alloc(&allocations, &deallocations);
+
+    auto res = allocated(std::allocator_arg, alloc, 1);
+    REQUIRE(res.value() == 2);
+
+    auto failed = allocated(std::allocator_arg, alloc, -1);
+    REQUIRE(failed.has_error());
+
+    // frames might get elided, but every allocation has to be freed
+    REQUIRE(allocations <= 2);
+    REQUIRE(allocations == deallocations);
+}
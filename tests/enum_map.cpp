@@ -0,0 +1,120 @@
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/enum_map.hpp>
+
+enum class DiskError : std::uint8_t {
+    missing,
+    denied,
+    corrupt = 5,
+};
+
+enum class ServiceError {
+    unavailable = -1,
+    not_found = 10,
+    forbidden,
+    broken,
+};
+
+template <>
+struct rescpp::type_converter<DiskError, ServiceError> : rescpp::enum_map<DiskError, ServiceError,
+    rescpp::enum_pair<DiskError::missing, ServiceError::not_found>,
+    rescpp::enum_pair<DiskError::denied, ServiceError::forbidden>,
+    rescpp::enum_pair<DiskError::corrupt, ServiceError::broken>> {};
+
+// same distance for every pair, converted with an addition
+enum class LowLevel {
+    first,
+    second,
+    third,
+};
+
+enum class HighLevel {
+    none,
+    first,
+    second,
+    third,
+};
+
+template <>
+struct rescpp::type_converter<LowLevel, HighLevel> : rescpp::enum_map<LowLevel, HighLevel,
+    rescpp::enum_pair<LowLevel::first, HighLevel::first>,
+    rescpp::enum_pair<LowLevel::second, HighLevel::second>,
+    rescpp::enum_pair<LowLevel::third, HighLevel::third>> {};
+
+// unscoped, negative values
+enum Signal {
+    signal_hangup = -2,
+    signal_stop = -1,
+    signal_none = 0,
+};
+
+template <>
+struct rescpp::type_converter<Signal, DiskError> : rescpp::enum_map<Signal, DiskError,
+    rescpp::enum_pair<signal_hangup, DiskError::corrupt>,
+    rescpp::enum_pair<signal_stop, DiskError::denied>,
+    rescpp::enum_pair<signal_none, DiskError::missing>> {};
+
+static_assert(rescpp::detail::has_type_converter<DiskError, ServiceError>);
+static_assert(rescpp::detail::has_type_converter<LowLevel, HighLevel>);
+static_assert(rescpp::type_converter<DiskError, ServiceError>::convert(DiskError::corrupt) == ServiceError::broken);
+static_assert(rescpp::type_converter<LowLevel, HighLevel>::convert(LowLevel::third) == HighLevel::third);
+static_assert(rescpp::type_converter<Signal, DiskError>::convert(signal_hangup) == DiskError::corrupt);
+
+static_assert(rescpp::detail::is_enumerator<DiskError::corrupt>());
+static_assert(!rescpp::detail::is_enumerator<static_cast<DiskError>(3)>());
+
+// incomplete mappings, 'enum_map' fails to compile for these
+enum PlainFrom {
+    plain_a,
+    plain_b,
+    plain_c,
+};
+
+// 'retry' is outside of the scan window, but between the pairs
+enum class WideFrom {
+    ok,
+    bad,
+    retry = 500,
+    timeout = 1000,
+};
+
+static_assert(!rescpp::detail::enum_map_covers_v<PlainFrom,
+    rescpp::enum_pair<plain_a, DiskError::missing>,
+    rescpp::enum_pair<plain_b, DiskError::denied>>);
+static_assert(!rescpp::detail::enum_map_covers_v<WideFrom,
+    rescpp::enum_pair<WideFrom::ok, DiskError::missing>,
+    rescpp::enum_pair<WideFrom::bad, DiskError::denied>,
+    rescpp::enum_pair<WideFrom::timeout, DiskError::corrupt>>);
+static_assert(rescpp::detail::enum_map_covers_v<WideFrom,
+    rescpp::enum_pair<WideFrom::ok, DiskError::missing>,
+    rescpp::enum_pair<WideFrom::bad, DiskError::denied>,
+    rescpp::enum_pair<WideFrom::retry, DiskError::denied>,
+    rescpp::enum_pair<WideFrom::timeout, DiskError::corrupt>>);
+
+static rescpp::result<int, DiskError> read_block(DiskError error) {
+    return rescpp::fail(error);
+}
+
+static rescpp::result<int, ServiceError> serve(DiskError error) {
+    auto block = RESCPP_TRY(read_block(error));
+    return block;
+}
+
+TEST_CASE("Enum map", "[enum_map]") {
+    SECTION("Table") {
+        REQUIRE(serve(DiskError::missing).error() == ServiceError::not_found);
+        REQUIRE(serve(DiskError::denied).error() == ServiceError::forbidden);
+        REQUIRE(serve(DiskError::corrupt).error() == ServiceError::broken);
+    }
+
+    SECTION("Offset") {
+        rescpp::result<int, HighLevel> res = rescpp::fail(LowLevel::second);
+        REQUIRE(res.error() == HighLevel::second);
+    }
+
+    SECTION("Unscoped") {
+        rescpp::result<void, DiskError> res = rescpp::fail(signal_stop);
+        REQUIRE(res.error() == DiskError::denied);
+    }
+}
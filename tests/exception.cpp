@@ -0,0 +1,98 @@
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/exception.hpp>
+
+enum class PortError {
+    not_a_number,
+    out_of_range,
+    unknown,
+};
+
+template <>
+struct rescpp::type_converter<std::out_of_range, PortError> {
+    static constexpr PortError convert(const std::out_of_range&) noexcept {
+        return PortError::out_of_range;
+    }
+};
+
+static PortError invalid_argument_error(const std::invalid_argument&) {
+    return PortError::not_a_number;
+}
+
+static rescpp::result<int, PortError> parse_port(const std::string& text) {
+    return rescpp::catch_as_result<PortError>(
+        [&text] { return std::stoi(text); },
+        rescpp::map_exception<std::out_of_range>,
+        invalid_argument_error,
+        [] { return PortError::unknown; });
+}
+
+TEST_CASE("catch_as_result", "[exception]") {
+    SECTION("Values") {
+        REQUIRE(parse_port("8080").value() == 8080);
+
+        auto nothing = rescpp::catch_as_result<PortError>([] {}, rescpp::map_exception<std::out_of_range>);
+        STATIC_REQUIRE(std::is_same_v<decltype(nothing), rescpp::result<void, PortError>>);
+        REQUIRE_FALSE(nothing.has_error());
+    }
+
+    SECTION("Mapped exceptions") {
+        REQUIRE(parse_port("99999999999").error() == PortError::out_of_range);
+        REQUIRE(parse_port("port").error() == PortError::not_a_number);
+
+        auto any = rescpp::catch_as_result<PortError>(
+            []() -> int { throw 42; },
+            rescpp::map_exception<std::out_of_range>,
+            [] { return PortError::unknown; });
+        REQUIRE(any.error() == PortError::unknown);
+    }
+
+    SECTION("First matching mapper") {
+        auto res = rescpp::catch_as_result<std::string>(
+            []() -> int { throw std::out_of_range("range"); },
+            [](const std::logic_error& ex) { return std::string("logic: ") + ex.what(); },
+            [](const std::out_of_range&) { return std::string("range"); });
+        REQUIRE(res.error() == "logic: range");
+    }
+
+    SECTION("Unmapped exceptions propagate") {
+        REQUIRE_THROWS_AS(rescpp::catch_as_result<PortError>(
+                              []() -> int { throw std::runtime_error("io"); },
+                              rescpp::map_exception<std::out_of_range>),
+                          std::runtime_error);
+    }
+
+    SECTION("Functions returning results") {
+        auto res = rescpp::catch_as_result<std::string>(
+            []() -> rescpp::result<int, std::string> { return rescpp::fail(std::string("bad")); },
+            [] { return std::string("unknown"); });
+        REQUIRE(res.error() == "bad");
+    }
+}
+
+TEST_CASE("value_or_throw", "[exception]") {
+    SECTION("Values") {
+        REQUIRE(rescpp::value_or_throw(parse_port("80")) == 80);
+
+        rescpp::result<std::string, PortError> name("config");
+        std::string& ref = rescpp::value_or_throw(name);
+        REQUIRE(&ref == &name.value());
+
+        rescpp::value_or_throw(rescpp::result<void, PortError>());
+    }
+
+    SECTION("Errors") {
+        try {
+            static_cast<void>(rescpp::value_or_throw(parse_port("port")));
+            FAIL("no exception");
+        }
+        catch (const rescpp::error_exception<PortError>& ex) {
+            REQUIRE(ex.error() == PortError::not_a_number);
+        }
+
+        REQUIRE_THROWS_AS(rescpp::value_or_throw<std::runtime_error>(rescpp::result<int, std::string>(rescpp::fail(std::string("io")))),
+                          std::runtime_error);
+    }
+}
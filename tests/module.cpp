@@ -0,0 +1,37 @@
+#include <coroutine>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+import rescpp;
+
+// built with 'RESCPP_ENABLE_MODULE' in its own executable,
+// uses the library only through the module, no header of it is included
+
+enum class ModuleError {
+    empty,
+};
+
+static rescpp::result<int, ModuleError> parse(const std::string& text) {
+    if (text.empty()) {
+        return rescpp::fail(ModuleError::empty);
+    }
+    return static_cast<int>(text.size());
+}
+
+static rescpp::result<int, ModuleError> doubled(const std::string& text) {
+    auto value = co_await parse(text);
+    co_return value * 2;
+}
+
+TEST_CASE("Module", "[module]") {
+    SECTION("co_await propagates errors") {
+        REQUIRE(doubled("abc").value() == 6);
+        REQUIRE(doubled("").error() == ModuleError::empty);
+    }
+
+    SECTION("Combinators") {
+        auto res = parse("ab").transform([](int value) { return value + 1; });
+        REQUIRE(res.value() == 3);
+    }
+}
@@ -0,0 +1,131 @@
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/res-cpp.hpp>
+
+// stateless error, only tells that something went wrong
+struct NotFound {};
+
+enum class Slot : std::uint8_t {
+    invalid,
+    first,
+    second,
+};
+
+template <>
+struct rescpp::niche_traits<Slot> : rescpp::sentinel_niche<Slot, Slot::invalid> {};
+
+// user type with a spare bit pattern, ports are never zero
+struct Port {
+    std::uint16_t number;
+
+    bool operator==(const Port& other) const = default;
+};
+
+template <>
+struct rescpp::niche_traits<Port> {
+    static constexpr Port niche() noexcept {
+        return Port{ 0 };
+    }
+
+    static constexpr bool is_niche(const Port& port) noexcept {
+        return port.number == 0;
+    }
+};
+
+enum class Status {
+    ok,
+    busy,
+    closed,
+};
+
+template <>
+struct rescpp::niche_traits<Status> : rescpp::sentinel_niche<Status, Status::ok> {};
+
+// niche path
+static_assert(sizeof(rescpp::result<void, Status>) == sizeof(Status));
+static_assert(std::is_trivially_copyable_v<rescpp::result<void, Status>>);
+static_assert(sizeof(rescpp::result<int&, NotFound>) == sizeof(int*));
+static_assert(sizeof(rescpp::result<const int&, NotFound>) == sizeof(const int*));
+static_assert(sizeof(rescpp::result<Slot, NotFound>) == sizeof(Slot));
+static_assert(sizeof(rescpp::result<Port, NotFound>) == sizeof(Port));
+
+// tagged path, error carries state or value has no niche
+static_assert(sizeof(rescpp::result<void, int>) == 2 * sizeof(int));
+static_assert(sizeof(rescpp::result<int&, int>) == 2 * sizeof(int*));
+static_assert(sizeof(rescpp::result<int, NotFound>) == 2 * sizeof(int));
+static_assert(sizeof(rescpp::result<Slot, int>) == 2 * sizeof(int));
+
+static int global_value = 42;
+
+constexpr rescpp::result<Slot, NotFound> find_slot(bool found) {
+    if (!found) {
+        return rescpp::fail(NotFound{});
+    }
+    return Slot::second;
+}
+
+TEST_CASE("Niche storage", "[niche]") {
+    SECTION("Reference value") {
+        rescpp::result<int&, NotFound> res = global_value;
+
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(&res.value() == &global_value);
+
+        rescpp::result<int&, NotFound> failed = rescpp::fail(NotFound{});
+        REQUIRE(failed.has_error());
+    }
+
+    SECTION("Enum sentinel") {
+        constexpr auto found = find_slot(true);
+        constexpr auto missing = find_slot(false);
+
+        static_assert(!found.has_error());
+        static_assert(found.value() == Slot::second);
+        static_assert(missing.has_error());
+
+        REQUIRE_FALSE(found.has_error());
+        REQUIRE(missing.has_error());
+    }
+
+    SECTION("User type with spare bit pattern") {
+        rescpp::result<Port, NotFound> res = Port{ 8080 };
+        auto copy = res;
+
+        REQUIRE_FALSE(copy.has_error());
+        REQUIRE(copy.value() == Port{ 8080 });
+
+        rescpp::result<Port, NotFound> failed = rescpp::fail(NotFound{});
+        auto failed_copy = failed;
+        REQUIRE(failed_copy.has_error());
+    }
+}
+
+TEST_CASE("Tagged storage without niche", "[niche]") {
+    rescpp::result<int&, int> res = global_value;
+    REQUIRE_FALSE(res.has_error());
+    REQUIRE(&res.value() == &global_value);
+
+    rescpp::result<int&, int> failed = rescpp::fail(7);
+    REQUIRE(failed.has_error());
+    REQUIRE(failed.error() == 7);
+}
+
+rescpp::result<void, Status> send(bool busy) {
+    if (busy) {
+        return rescpp::fail(Status::busy);
+    }
+    return {};
+}
+
+TEST_CASE("Niche storage for void result", "[niche]") {
+    auto res = send(false);
+    REQUIRE_FALSE(res.has_error());
+
+    res = send(true);
+    REQUIRE(res.has_error());
+    REQUIRE(res.error() == Status::busy);
+
+    res = {};
+    REQUIRE_FALSE(res.has_error());
+}
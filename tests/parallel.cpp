@@ -0,0 +1,187 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/parallel.hpp>
+
+struct ParallelError {
+    std::size_t index;
+};
+
+// no default constructor, values are collected through optional slots
+struct Labeled {
+    std::string label;
+
+    explicit Labeled(std::string text)
+        : label(std::move(text)) {}
+};
+
+// allocations left on this thread before 'operator new' throws, negative never throws
+static thread_local int allocations_until_failure = -1;
+
+void* operator new(std::size_t size) {
+    if (allocations_until_failure == 0) {
+        throw std::bad_alloc();
+    }
+    if (allocations_until_failure > 0) {
+        --allocations_until_failure;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// kept out of line, gcc warns about the inlined free of a pointer from operator new
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+static std::vector<int> numbers(int count) {
+    std::vector<int> values(static_cast<std::size_t>(count));
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+}
+
+TEST_CASE("Parallel transform", "[parallel]") {
+    rescpp::thread_pool pool(4);
+
+    SECTION("Values in order") {
+        const auto input = numbers(1000);
+        auto res = rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<int, ParallelError> {
+            return value * 2;
+        });
+
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(res.value().size() == 1000);
+        for (std::size_t i = 0; i < 1000; ++i) {
+            REQUIRE(res.value()[i] == static_cast<int>(i) * 2);
+        }
+    }
+
+    SECTION("Empty range") {
+        const std::vector<int> input;
+        auto res = rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<int, ParallelError> {
+            return value;
+        });
+
+        REQUIRE(res.value().empty());
+    }
+
+    SECTION("Lowest index error") {
+        const auto input = numbers(2000);
+        for (int run = 0; run < 20; ++run) {
+            auto res = rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<int, ParallelError> {
+                if (value == 317 || value == 318 || value == 1200 || value == 1999) {
+                    return rescpp::fail(ParallelError{ static_cast<std::size_t>(value) });
+                }
+                return value;
+            }, 7);
+
+            REQUIRE(res.has_error());
+            REQUIRE(res.error().index == 317);
+        }
+    }
+
+    SECTION("Cancels the rest of a chunk") {
+        const auto input = numbers(500);
+        std::atomic<int> calls = 0;
+        auto res = rescpp::parallel_transform(pool, input, [&calls](int value) -> rescpp::result<int, ParallelError> {
+            ++calls;
+            return rescpp::fail(ParallelError{ static_cast<std::size_t>(value) });
+        }, 500);
+
+        REQUIRE(res.error().index == 0);
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Void results") {
+        const auto input = numbers(100);
+        std::atomic<int> sum = 0;
+        rescpp::result<void, ParallelError> res = rescpp::parallel_transform(pool, input, [&sum](int value) -> rescpp::result<void, ParallelError> {
+            sum += value;
+            return {};
+        });
+
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(sum == 4950);
+    }
+
+    SECTION("Values without default constructor") {
+        const auto input = numbers(50);
+        auto res = rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<Labeled, ParallelError> {
+            return Labeled(std::to_string(value));
+        });
+
+        REQUIRE(res.value().size() == 50);
+        REQUIRE(res.value()[42].label == "42");
+    }
+
+    SECTION("Exceptions are rethrown") {
+        const auto input = numbers(100);
+        REQUIRE_THROWS_AS(rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<int, ParallelError> {
+            if (value == 60) {
+                throw std::runtime_error("failed");
+            }
+            return value;
+        }), std::runtime_error);
+    }
+
+    SECTION("Throwing submit waits for queued chunks") {
+        const auto input = numbers(64);
+        std::atomic<int> calls = 0;
+        // the result vector and the first few tasks are allocated, a later submit throws
+        allocations_until_failure = 4;
+        REQUIRE_THROWS_AS(rescpp::parallel_transform(pool, input, [&calls](int value) -> rescpp::result<int, ParallelError> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            calls.fetch_add(1);
+            return value;
+        }, 1), std::bad_alloc);
+        allocations_until_failure = -1;
+        const int finished = calls.load();
+        REQUIRE(finished < 64);
+
+        // queued chunks have finished before the exception left 'parallel_transform'
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(calls.load() == finished);
+
+        auto res = rescpp::parallel_transform(pool, input, [](int value) -> rescpp::result<int, ParallelError> {
+            return value;
+        });
+        REQUIRE(res.value().size() == 64);
+    }
+
+    SECTION("Nested on the same pool") {
+        const auto input = numbers(16);
+        auto res = rescpp::parallel_transform(pool, input, [&pool](int outer) -> rescpp::result<int, ParallelError> {
+            const auto inner_input = numbers(outer);
+            auto inner = rescpp::parallel_transform(pool, inner_input, [](int value) -> rescpp::result<int, ParallelError> {
+                return value;
+            });
+            auto values = RESCPP_TRY(std::move(inner));
+            return std::accumulate(values.begin(), values.end(), 0);
+        });
+
+        REQUIRE(res.value()[16 - 1] == 105);
+    }
+}
+
+TEST_CASE("Parallel transform on the shared pool", "[parallel]") {
+    const auto input = numbers(64);
+    auto res = rescpp::parallel_transform(input, [](int value) -> rescpp::result<int, ParallelError> {
+        return value + 1;
+    });
+
+    REQUIRE(res.value().back() == 64);
+}
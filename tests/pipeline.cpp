@@ -0,0 +1,154 @@
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/pipeline.hpp>
+
+enum class ParseError {
+    empty,
+    negative,
+};
+
+struct ConfigError {
+    std::string message;
+};
+
+template <>
+struct rescpp::type_converter<ParseError, ConfigError> {
+    static ConfigError convert(const ParseError& error) noexcept {
+        return ConfigError{ error == ParseError::empty ? "empty" : "negative" };
+    }
+};
+
+static rescpp::result<int, ParseError> parse_length(const std::string& text) {
+    if (text.empty()) {
+        return rescpp::fail(ParseError::empty);
+    }
+    return static_cast<int>(text.size());
+}
+
+static rescpp::result<int, ConfigError> check_limit(int value) {
+    if (value > 8) {
+        return rescpp::fail(ConfigError{ "too long" });
+    }
+    return value;
+}
+
+// Counts copies and moves of the error, a pipeline should only ever move it
+struct TrackedError {
+    int* copies;
+    int* moves;
+
+    TrackedError(int* copy_count, int* move_count)
+        : copies(copy_count), moves(move_count) {}
+
+    TrackedError(const TrackedError& other)
+        : copies(other.copies), moves(other.moves) {
+        ++*copies;
+    }
+
+    TrackedError(TrackedError&& other) noexcept
+        : copies(other.copies), moves(other.moves) {
+        ++*moves;
+    }
+};
+
+TEST_CASE("Pipeline", "[pipeline]") {
+    const rescpp::pipeline parse_config(
+        rescpp::and_then(parse_length),
+        rescpp::transform([](int value) { return value * 2; }),
+        rescpp::and_then(check_limit)
+    );
+
+    SECTION("Value path") {
+        rescpp::result<std::string, ParseError> text = std::string("abc");
+        auto res = parse_config(text);
+
+        STATIC_REQUIRE(std::is_same_v<decltype(res), rescpp::result<int, ConfigError>>);
+        REQUIRE(res.value() == 6);
+    }
+
+    SECTION("Error from step is converted") {
+        rescpp::result<std::string, ParseError> text = std::string();
+        auto res = text | parse_config;
+
+        REQUIRE(res.error().message == "empty");
+
+        rescpp::result<std::string, ParseError> long_text = std::string("abcdefgh");
+        REQUIRE((long_text | parse_config).error().message == "too long");
+    }
+
+    SECTION("Error from input skips every value step") {
+        int calls = 0;
+        const rescpp::pipeline counted(
+            rescpp::transform([&calls](int value) { ++calls; return value; }),
+            rescpp::and_then([&calls](int value) -> rescpp::result<int, ParseError> { ++calls; return value; })
+        );
+
+        rescpp::result<int, ParseError> failed = rescpp::fail(ParseError::negative);
+        REQUIRE(counted(failed).error() == ParseError::negative);
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("or_else and transform_error") {
+        const rescpp::pipeline recover(
+            rescpp::transform_error([](ParseError error) { return static_cast<int>(error); }),
+            rescpp::or_else([](int code) -> rescpp::result<int, std::string> {
+                if (code == 0) {
+                    return 0;
+                }
+                return rescpp::fail(std::string("unrecoverable"));
+            })
+        );
+
+        REQUIRE(recover(parse_length("")).value() == 0);
+        REQUIRE(recover(parse_length("abc")).value() == 3);
+        REQUIRE(recover(rescpp::result<int, ParseError>(rescpp::fail(ParseError::negative))).error() == "unrecoverable");
+    }
+
+    SECTION("void values") {
+        int seen = 0;
+        const rescpp::pipeline store(
+            rescpp::transform([&seen](int value) { seen = value; }),
+            rescpp::transform([] { return 1; })
+        );
+
+        auto res = store(rescpp::result<int, ParseError>(5));
+        REQUIRE(seen == 5);
+        REQUIRE(res.value() == 1);
+    }
+
+    SECTION("Error is moved, not copied") {
+        int copies = 0;
+        int moves = 0;
+        const rescpp::pipeline pass(
+            rescpp::transform([](int value) { return value + 1; }),
+            rescpp::and_then([](int value) -> rescpp::result<int, TrackedError> { return value; }),
+            rescpp::transform([](int value) { return value + 1; })
+        );
+
+        rescpp::result<int, TrackedError> failed = rescpp::fail<TrackedError>(&copies, &moves);
+        copies = 0;
+        moves = 0;
+
+        auto res = pass(std::move(failed));
+        REQUIRE(res.has_error());
+        REQUIRE(copies == 0);
+        // only into the output result
+        REQUIRE(moves == 1);
+    }
+}
+
+TEST_CASE("Pipeline constexpr", "[pipeline]") {
+    constexpr rescpp::pipeline twice(
+        rescpp::transform([](int value) { return value * 2; }),
+        rescpp::and_then([](int value) -> rescpp::result<int, int> {
+            if (value > 10) {
+                return rescpp::fail(value);
+            }
+            return value;
+        })
+    );
+
+    STATIC_REQUIRE(twice(rescpp::result<int, int>(4)).value() == 8);
+    STATIC_REQUIRE(twice(rescpp::result<int, int>(6)).error() == 12);
+}
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/profiler.hpp>
+
+// compiled with 'RESCPP_ENABLE_PROFILER' in its own executable
+
+static_assert(rescpp::profiler::enabled);
+
+struct ParseError {
+    int position;
+};
+
+[[gnu::noinline]]
+static rescpp::result<int, ParseError> parse(int value) {
+    if (value < 0) {
+        return rescpp::fail(ParseError{ value });
+    }
+    return value;
+}
+
+static std::string folded_stacks() {
+    std::FILE* file = std::tmpfile();
+    rescpp::profiler::write_folded(file);
+    std::string content(static_cast<std::size_t>(std::ftell(file)), '\0');
+    std::rewind(file);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+    return content;
+}
+
+TEST_CASE("Sampling error profiler", "[profiler]") {
+    rescpp::profiler::clear();
+
+    SECTION("One out of interval errors") {
+        rescpp::profiler::set_sample_interval(4);
+        REQUIRE(rescpp::profiler::start());
+        REQUIRE_FALSE(rescpp::profiler::start());
+        for (int i = 0; i < 40; ++i) {
+            static_cast<void>(parse(-1));
+            // values are not sampled
+            static_cast<void>(parse(1));
+        }
+        rescpp::profiler::stop();
+
+        REQUIRE(rescpp::profiler::samples() + rescpp::profiler::dropped() == 10);
+    }
+
+    SECTION("Folded stacks end with the error type") {
+        rescpp::profiler::set_sample_interval(1);
+        rescpp::profiler::start();
+        static_cast<void>(parse(-1));
+        rescpp::profiler::stop();
+
+        const std::string stacks = folded_stacks();
+        REQUIRE(stacks.find(";[ParseError] 1\n") != std::string::npos);
+    }
+
+    SECTION("Errors of other threads") {
+        rescpp::profiler::set_sample_interval(1);
+        rescpp::profiler::start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([] {
+                // the interval of other threads applies after their first sample
+                rescpp::profiler::set_sample_interval(1);
+                for (int i = 0; i < 16; ++i) {
+                    static_cast<void>(parse(-1));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        rescpp::profiler::stop();
+
+        REQUIRE(rescpp::profiler::samples() + rescpp::profiler::dropped() == 64);
+    }
+
+    SECTION("Nothing gets sampled while stopped") {
+        rescpp::profiler::set_sample_interval(1);
+        static_cast<void>(parse(-1));
+
+        REQUIRE(rescpp::profiler::samples() == 0);
+    }
+}
@@ -123,6 +123,142 @@ TEST_CASE("Result with void value type", "[result]") {
         REQUIRE(res.error().code == 1);
         REQUIRE(res.error().message == "operation failed");
     }
+
+    SECTION("Move void result") {
+        rescpp::result<void, TestError> res =
+            rescpp::fail<TestError>(1, "operation failed");
+        auto moved = std::move(res);
+
+        REQUIRE(moved.has_error());
+        REQUIRE(moved.error().message == "operation failed");
+    }
+
+    SECTION("Assign void result") {
+        rescpp::result<void, TestError> res;
+
+        res = rescpp::fail<TestError>(1, "first");
+        REQUIRE(res.has_error());
+        REQUIRE(res.error().message == "first");
+
+        rescpp::result<void, TestError> other = rescpp::fail<TestError>(2, "second");
+        res = other;
+        REQUIRE(res.has_error());
+        REQUIRE(res.error().code == 2);
+        REQUIRE(other.error().message == "second");
+
+        res = rescpp::result<void, TestError>();
+        REQUIRE_FALSE(res.has_error());
+    }
+
+    SECTION("Reuse void result in loop") {
+        rescpp::result<void, TestError> res;
+        int failures = 0;
+
+        for (int i = 0; i < 8; ++i) {
+            if (i % 2 == 0) {
+                res = rescpp::fail<TestError>(i, "even");
+            }
+            else {
+                res = {};
+            }
+
+            if (res.has_error()) {
+                ++failures;
+                REQUIRE(res.error().code == i);
+            }
+        }
+        REQUIRE(failures == 4);
+    }
+}
+
+// throws on construction from an int, to check the state is kept
+struct ThrowingValue {
+    std::string text;
+
+    explicit ThrowingValue(int value) {
+        if (value < 0) {
+            throw std::runtime_error("negative");
+        }
+        text = std::to_string(value);
+    }
+};
+
+TEST_CASE("Result assignment and emplace", "[result][assign]") {
+    SECTION("Value assignment reuses the buffer") {
+        rescpp::result<std::string, TestError> res(std::string(64, 'x'));
+        const char* buffer = res.value().data();
+
+        res = std::string_view("short");
+        REQUIRE(res.value() == "short");
+        REQUIRE(res.value().data() == buffer);
+
+        const std::string other(32, 'y');
+        res = other;
+        REQUIRE(res.value() == other);
+        REQUIRE(res.value().data() == buffer);
+    }
+
+    SECTION("Value and failure assignment change the state") {
+        rescpp::result<std::string, TestError> res = rescpp::fail<TestError>(1, "first");
+
+        res = "value";
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(res.value() == "value");
+
+        res = rescpp::fail<TestError>(2, "second");
+        REQUIRE(res.error().code == 2);
+
+        res = rescpp::fail<TestError>(3, "third");
+        REQUIRE(res.error() == TestError(3, "third"));
+    }
+
+    SECTION("emplace and emplace_error") {
+        rescpp::result<std::string, TestError> res = rescpp::fail<TestError>(1, "failed");
+
+        std::string& value = res.emplace(3, 'a');
+        REQUIRE(value == "aaa");
+        REQUIRE(&value == &res.value());
+
+        TestError& error = res.emplace_error(4, "again");
+        REQUIRE(res.has_error());
+        REQUIRE(&error == &res.error());
+
+        res.emplace_error(5, "replaced");
+        REQUIRE(res.error().code == 5);
+
+        int number = 1;
+        rescpp::result<int&, TestError> ref = rescpp::fail<TestError>(1, "failed");
+        ref.emplace(number);
+        REQUIRE(&ref.value() == &number);
+
+        rescpp::result<void, TestError> nothing;
+        nothing.emplace_error(6, "void");
+        REQUIRE(nothing.error().code == 6);
+        nothing.emplace();
+        REQUIRE_FALSE(nothing.has_error());
+    }
+
+    SECTION("Strong guarantee on throwing construction") {
+        rescpp::result<ThrowingValue, TestError> res = rescpp::fail<TestError>(1, "kept");
+        REQUIRE_THROWS_AS(res.emplace(-1), std::runtime_error);
+        REQUIRE(res.error() == TestError(1, "kept"));
+
+        res.emplace(7);
+        REQUIRE_THROWS_AS(res.emplace(-1), std::runtime_error);
+        REQUIRE(res.value().text == "7");
+    }
+
+    SECTION("constexpr") {
+        constexpr auto emplaced = [] {
+            rescpp::result<int, int> res = rescpp::fail(1);
+            res.emplace(2);
+            res = 3;
+            res = rescpp::fail(4);
+            res.emplace_error(5);
+            return res.error();
+        }();
+        STATIC_REQUIRE(emplaced == 5);
+    }
 }
 
 TEST_CASE("Failure handling", "[failure]") {
@@ -375,3 +511,130 @@ TEST_CASE("Constexpr support", "[constexpr]") {
     REQUIRE(failure.has_error());
     REQUIRE(failure.error() == 1);
 }
+
+// Test trivial special members
+enum class TrivialError {
+    failed,
+};
+
+static_assert(std::is_trivially_copyable_v<rescpp::result<int, TrivialError>>);
+static_assert(std::is_trivially_copyable_v<rescpp::result<double, int>>);
+static_assert(std::is_trivially_copyable_v<rescpp::result<int&, TrivialError>>);
+static_assert(std::is_trivially_copyable_v<rescpp::result<const int&, TrivialError>>);
+static_assert(std::is_trivially_destructible_v<rescpp::result<int, TrivialError>>);
+static_assert(std::is_trivially_copyable_v<rescpp::failure<TrivialError>>);
+static_assert(std::is_trivially_copyable_v<rescpp::result<void, TrivialError>>);
+
+static_assert(!std::is_trivially_copyable_v<rescpp::result<std::string, TrivialError>>);
+static_assert(!std::is_trivially_copyable_v<rescpp::result<int, TestError>>);
+static_assert(!std::is_trivially_destructible_v<rescpp::result<int, TestError>>);
+
+TEST_CASE("Trivial result", "[result][trivial]") {
+    auto make = [](bool fail) -> rescpp::result<int, TrivialError> {
+        if (fail) {
+            return rescpp::fail(TrivialError::failed);
+        }
+        return 42;
+    };
+
+    auto good = make(false);
+    auto copy = good;
+    REQUIRE_FALSE(copy.has_error());
+    REQUIRE(copy.value() == 42);
+
+    auto bad = make(true);
+    auto moved = std::move(bad);
+    REQUIRE(moved.has_error());
+    REQUIRE(moved.error() == TrivialError::failed);
+}
+
+// Test combinators
+rescpp::result<int, TestError> parse_positive(int value) {
+    if (value < 0) {
+        return rescpp::fail<TestError>(3, "negative");
+    }
+    return value;
+}
+
+TEST_CASE("Result combinators", "[result][combinators]") {
+    SECTION("and_then") {
+        rescpp::result<int, TestError> res = 21;
+        auto next = res.and_then(parse_positive);
+
+        REQUIRE(next.value() == 21);
+        REQUIRE(rescpp::result<int, TestError>(-1).and_then(parse_positive).error().code == 3);
+
+        rescpp::result<int, TestError> failed = rescpp::fail<TestError>(1, "first");
+        auto skipped = failed.and_then([](int) -> rescpp::result<int, OtherError> {
+            FAIL("should not be called");
+            return 0;
+        });
+        REQUIRE(skipped.error().reason == "Converted: first");
+    }
+
+    SECTION("transform") {
+        rescpp::result<int, TestError> res = 21;
+        auto doubled = res.transform([](int value) { return value * 2.0; });
+        STATIC_REQUIRE(std::is_same_v<decltype(doubled), rescpp::result<double, TestError>>);
+        REQUIRE(doubled.value() == 42.0);
+
+        rescpp::result<int, TestError> failed = rescpp::fail<TestError>(1, "failed");
+        REQUIRE(failed.transform([](int value) { return value * 2; }).error().code == 1);
+
+        auto as_void = res.transform([](int) {});
+        STATIC_REQUIRE(std::is_same_v<decltype(as_void), rescpp::result<void, TestError>>);
+        REQUIRE_FALSE(as_void.has_error());
+    }
+
+    SECTION("transform_error") {
+        rescpp::result<int, TestError> failed = rescpp::fail<TestError>(1, "failed");
+        auto mapped = std::move(failed).transform_error([](TestError&& error) {
+            return OtherError(std::move(error.message));
+        });
+        REQUIRE(mapped.error().reason == "failed");
+
+        rescpp::result<int, TestError> res = 1;
+        REQUIRE(res.transform_error([](const TestError&) { return 0; }).value() == 1);
+    }
+
+    SECTION("or_else") {
+        rescpp::result<int, TestError> failed = rescpp::fail<TestError>(1, "failed");
+        auto recovered = failed.or_else([](const TestError& error) -> rescpp::result<int, OtherError> {
+            return error.code * 10;
+        });
+        REQUIRE(recovered.value() == 10);
+
+        rescpp::result<int, TestError> res = 1;
+        auto kept = res.or_else([](const TestError&) -> rescpp::result<int, OtherError> {
+            return rescpp::fail(OtherError("unused"));
+        });
+        REQUIRE(kept.value() == 1);
+    }
+
+    SECTION("value_or_else") {
+        rescpp::result<int, TestError> failed = rescpp::fail<TestError>(7, "failed");
+        REQUIRE(failed.value_or_else([](const TestError& error) { return -error.code; }) == -7);
+
+        rescpp::result<int, TestError> res = 1;
+        REQUIRE(res.value_or_else([](const TestError&) { return 0; }) == 1);
+    }
+
+    SECTION("void result") {
+        rescpp::result<void, TestError> res;
+        REQUIRE(res.and_then([] { return parse_positive(5); }).value() == 5);
+        REQUIRE(res.transform([] { return 2; }).value() == 2);
+
+        rescpp::result<void, TestError> failed = rescpp::fail<TestError>(1, "failed");
+        auto recovered = failed.or_else([](const TestError&) -> rescpp::result<void, OtherError> {
+            return {};
+        });
+        REQUIRE_FALSE(recovered.has_error());
+    }
+
+    SECTION("constexpr") {
+        constexpr auto res = rescpp::result<int, int>(20)
+                             .transform([](int value) { return value + 1; })
+                             .and_then([](int value) -> rescpp::result<int, int> { return value * 2; });
+        STATIC_REQUIRE(res.value() == 42);
+    }
+}
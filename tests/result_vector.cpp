@@ -0,0 +1,99 @@
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/result_vector.hpp>
+
+struct BatchError {
+    int code;
+    std::string message;
+};
+
+using BatchVector = rescpp::result_vector<int, BatchError>;
+
+static_assert(std::ranges::forward_range<BatchVector::value_range>);
+
+static BatchVector make_batch(std::size_t size, std::size_t error_every) {
+    BatchVector batch;
+    batch.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (i % error_every == 0) {
+            batch.push_back(rescpp::fail(BatchError{ static_cast<int>(i), "failed" }));
+        }
+        else {
+            batch.push_back(static_cast<int>(i));
+        }
+    }
+    return batch;
+}
+
+TEST_CASE("Result vector", "[result_vector]") {
+    SECTION("Indexed access") {
+        const auto batch = make_batch(10, 3);
+
+        REQUIRE(batch.size() == 10);
+        REQUIRE(batch.error_count() == 4);
+        REQUIRE(batch[0].has_error());
+        REQUIRE(batch[0].error().code == 0);
+        REQUIRE(batch[6].error().code == 6);
+        REQUIRE(batch[7].value() == 7);
+        REQUIRE_FALSE(batch.has_error(8));
+        REQUIRE_THROWS_AS(batch[3].value(), rescpp::detail::bad_result_access_exception);
+    }
+
+    SECTION("Values only") {
+        const auto batch = make_batch(200, 7);
+
+        std::vector<int> values;
+        for (const int value : batch.values()) {
+            values.push_back(value);
+        }
+
+        std::vector<int> expected;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 7 != 0) {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(values == expected);
+    }
+
+    SECTION("Errors only") {
+        const auto batch = make_batch(200, 50);
+
+        std::vector<std::size_t> indices;
+        for (const auto& error : batch.errors()) {
+            REQUIRE(error.error.code == static_cast<int>(error.index));
+            indices.push_back(error.index);
+        }
+        REQUIRE(indices == std::vector<std::size_t>{ 0, 50, 100, 150 });
+    }
+
+    SECTION("Error bitmap") {
+        const auto batch = make_batch(130, 64);
+        const auto bits = batch.error_bits();
+
+        REQUIRE(bits.size() == 3);
+        REQUIRE(bits[0] == 1);
+        REQUIRE(bits[1] == 1);
+        REQUIRE(bits[2] == 1);
+        REQUIRE(batch.value_slots().size() == 130);
+        REQUIRE(batch.value_slots()[64] == 0);
+    }
+
+    SECTION("Only errors") {
+        const auto batch = make_batch(100, 1);
+        REQUIRE(batch.values().begin() == batch.values().end());
+        REQUIRE(batch.error_count() == 100);
+    }
+
+    SECTION("Moves from rvalue results") {
+        rescpp::result_vector<std::string, int> strings;
+        rescpp::result<std::string, int> res = std::string(100, 'x');
+        strings.push_back(std::move(res));
+
+        REQUIRE(strings[0].value().size() == 100);
+    }
+}
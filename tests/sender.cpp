@@ -0,0 +1,196 @@
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/sender.hpp>
+
+enum class StageError {
+    empty,
+    negative,
+};
+
+struct PipelineError {
+    StageError stage;
+
+    PipelineError(StageError error)
+        : stage(error) {}
+};
+
+static rescpp::result<int, StageError> parse_stage(const std::string& text) {
+    if (text.empty()) {
+        return rescpp::fail(StageError::empty);
+    }
+    return std::stoi(text);
+}
+
+static rescpp::result<int, StageError> check_stage(int value) {
+    if (value < 0) {
+        return rescpp::fail(StageError::negative);
+    }
+    return value;
+}
+
+// records how the sender completed
+template <typename V, typename E>
+struct RecordingReceiver {
+    std::optional<V>* value;
+    std::optional<E>* error;
+    std::exception_ptr* exception = nullptr;
+
+    void set_value(V val) && {
+        value->emplace(std::move(val));
+    }
+
+    void set_error(E err) && {
+        error->emplace(std::move(err));
+    }
+
+    void set_error(std::exception_ptr err) && {
+        *exception = std::move(err);
+    }
+};
+
+TEST_CASE("Result senders", "[sender]") {
+    SECTION("Values and errors take their own channel") {
+        std::optional<int> value;
+        std::optional<StageError> error;
+
+        auto good = rescpp::connect(rescpp::as_sender(check_stage(3)), RecordingReceiver<int, StageError>{ &value, &error });
+        good.start();
+        REQUIRE(value == 3);
+        REQUIRE_FALSE(error.has_value());
+
+        value.reset();
+        auto bad = rescpp::connect(rescpp::as_sender(check_stage(-3)), RecordingReceiver<int, StageError>{ &value, &error });
+        bad.start();
+        REQUIRE_FALSE(value.has_value());
+        REQUIRE(error == StageError::negative);
+    }
+
+    SECTION("then_result") {
+        auto good = rescpp::sync_wait(rescpp::as_sender(parse_stage("12"))
+                                      | rescpp::then_result(check_stage)
+                                      | rescpp::then_result([](int value) -> rescpp::result<std::string, PipelineError> {
+                                            return std::to_string(value * 2);
+                                        }));
+        REQUIRE(good.value() == "24");
+
+        // errors skip the following stages and get converted to their error type
+        int calls = 0;
+        auto bad = rescpp::sync_wait(rescpp::as_sender(parse_stage(""))
+                                     | rescpp::then_result([&calls](int value) -> rescpp::result<int, PipelineError> {
+                                           ++calls;
+                                           return value;
+                                       }));
+        REQUIRE(bad.error().stage == StageError::empty);
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("let_result") {
+        auto res = rescpp::sync_wait(rescpp::as_sender(parse_stage("5"))
+                                     | rescpp::let_result([](int value) {
+                                           return rescpp::as_sender(check_stage(value - 10));
+                                       }));
+        REQUIRE(res.error() == StageError::negative);
+
+        auto nested = rescpp::sync_wait(rescpp::let_result(rescpp::as_sender(parse_stage("5")), [](int& value) {
+            return rescpp::as_sender(check_stage(value))
+                | rescpp::then_result([&value](int checked) -> rescpp::result<int, StageError> {
+                      // 'value' lives in the operation until it completes
+                      return checked + value;
+                  });
+        }));
+        REQUIRE(nested.value() == 10);
+    }
+
+    SECTION("Void values") {
+        auto res = rescpp::sync_wait(rescpp::as_sender(rescpp::result<void, StageError>())
+                                     | rescpp::then_result([]() -> rescpp::result<int, StageError> {
+                                           return 1;
+                                       }));
+        REQUIRE(res.value() == 1);
+    }
+
+    SECTION("Exceptions go to set_error") {
+        std::optional<int> value;
+        std::optional<StageError> error;
+        std::exception_ptr exception;
+
+        auto operation = rescpp::connect(rescpp::as_sender(parse_stage("3"))
+                                             | rescpp::then_result([](int) -> rescpp::result<int, StageError> {
+                                                   throw std::runtime_error("stage");
+                                               }),
+                                         RecordingReceiver<int, StageError>{ &value, &error, &exception });
+        operation.start();
+        REQUIRE(exception != nullptr);
+        REQUIRE_FALSE(value.has_value());
+        REQUIRE_FALSE(error.has_value());
+
+        // 'sync_wait' rethrows them, later stages do not run
+        int calls = 0;
+        REQUIRE_THROWS_AS(rescpp::sync_wait(rescpp::as_sender(parse_stage("3"))
+                                            | rescpp::let_result([](int) -> rescpp::result_sender<int, StageError> {
+                                                  throw std::runtime_error("stage");
+                                              })
+                                            | rescpp::then_result([&calls](int value) -> rescpp::result<int, StageError> {
+                                                  ++calls;
+                                                  return value;
+                                              })), std::runtime_error);
+        REQUIRE(calls == 0);
+    }
+}
+
+TEST_CASE("Schedulers", "[sender]") {
+    SECTION("Run loop") {
+        rescpp::run_loop loop;
+        std::optional<int> value;
+        std::optional<StageError> error;
+
+        auto operation = rescpp::connect(rescpp::schedule(loop.get_scheduler())
+                                             | rescpp::then_result([] { return parse_stage("7"); }),
+                                         RecordingReceiver<int, StageError>{ &value, &error });
+        operation.start();
+        // nothing runs before the loop does
+        REQUIRE_FALSE(value.has_value());
+
+        loop.finish();
+        loop.run();
+        REQUIRE(value == 7);
+    }
+
+    SECTION("sync_wait runs the loop") {
+        rescpp::run_loop loop;
+        const auto caller = std::this_thread::get_id();
+
+        auto res = rescpp::sync_wait(loop, rescpp::schedule(loop.get_scheduler())
+                                               | rescpp::then_result([caller]() -> rescpp::result<bool, StageError> {
+                                                     return std::this_thread::get_id() == caller;
+                                                 }));
+        REQUIRE(res.value());
+
+        // the loop is not finished, it can be driven again
+        auto again = rescpp::sync_wait(loop, rescpp::schedule(loop.get_scheduler())
+                                                 | rescpp::then_result([] { return parse_stage(""); }));
+        REQUIRE(again.error() == StageError::empty);
+    }
+
+    SECTION("Thread pool") {
+        rescpp::thread_pool pool(2);
+        const auto caller = std::this_thread::get_id();
+
+        auto res = rescpp::sync_wait(rescpp::schedule(rescpp::pool_scheduler(pool))
+                                     | rescpp::then_result([caller]() -> rescpp::result<bool, StageError> {
+                                           return std::this_thread::get_id() != caller;
+                                       })
+                                     | rescpp::let_result([&pool](bool on_worker) {
+                                           return rescpp::schedule(rescpp::pool_scheduler(pool))
+                                               | rescpp::then_result([on_worker]() -> rescpp::result<bool, StageError> {
+                                                     return on_worker;
+                                                 });
+                                       }));
+        REQUIRE(res.value());
+    }
+}
@@ -0,0 +1,141 @@
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/coroutine.hpp>
+#include <res-cpp/parallel.hpp>
+#include <res-cpp/stats.hpp>
+
+// compiled with 'RESCPP_ENABLE_STATS' in its own executable
+
+static_assert(rescpp::stats::enabled);
+
+struct ParseError {
+    int position;
+};
+
+struct ConfigError {
+    ParseError parse;
+
+    ConfigError(ParseError error)
+        : parse(error) {}
+};
+
+static rescpp::result<int, ParseError> parse(bool fail) {
+    if (fail) {
+        return rescpp::fail(ParseError{ 3 });
+    }
+    return 1;
+}
+
+static rescpp::result<int, ConfigError> load(bool fail) {
+    auto value = RESCPP_TRY(parse(fail));
+    return value + 1;
+}
+
+static rescpp::result<int, ConfigError> load_awaiting(bool fail) {
+    co_return co_await parse(fail);
+}
+
+static std::uint64_t created_parse_errors() {
+    return rescpp::stats::snapshot().count<ParseError>(rescpp::stats::event::created);
+}
+
+static std::uint64_t propagated_parse_errors() {
+    return rescpp::stats::snapshot().count<ParseError>(rescpp::stats::event::propagated);
+}
+
+// runs first, the registry has to be created by a worker of the shared pool (after the pool)
+// the pool joins its workers during static destruction, their tables unregister after that
+TEST_CASE("Error counters of pool workers", "[stats]") {
+    std::atomic<bool> done = false;
+    rescpp::thread_pool::shared().submit([&done] {
+        static_cast<void>(parse(true));
+        done.store(true, std::memory_order_release);
+    });
+    while (!done.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(created_parse_errors() == 1);
+}
+
+TEST_CASE("Error counters", "[stats]") {
+    SECTION("Created and propagated per type") {
+        const auto created = created_parse_errors();
+        const auto propagated = propagated_parse_errors();
+
+        REQUIRE(load(true).has_error());
+        REQUIRE_FALSE(load(false).has_error());
+        REQUIRE(load_awaiting(true).has_error());
+
+        REQUIRE(created_parse_errors() == created + 2);
+        REQUIRE(propagated_parse_errors() == propagated + 2);
+        REQUIRE(rescpp::stats::snapshot().count<ConfigError>(rescpp::stats::event::created) == 0);
+    }
+
+    SECTION("Call sites") {
+        static_cast<void>(load(true));
+        const auto report = rescpp::stats::snapshot();
+
+        bool found_fail = false;
+        bool found_try = false;
+        for (const auto& site : report.sites()) {
+            if (site.type == "ParseError" && std::string_view(site.location.file_name()).ends_with("stats.cpp")) {
+                found_fail = found_fail || (site.kind == rescpp::stats::event::created && site.location.line() == 30);
+                found_try = found_try || (site.kind == rescpp::stats::event::propagated && site.location.line() == 36);
+            }
+        }
+        REQUIRE(found_fail);
+        REQUIRE(found_try);
+    }
+
+    SECTION("Counters of exited threads") {
+        const auto created = created_parse_errors();
+        std::thread([] {
+            for (int i = 0; i < 10; ++i) {
+                static_cast<void>(parse(true));
+            }
+        }).join();
+
+        REQUIRE(created_parse_errors() == created + 10);
+    }
+
+    SECTION("Merge") {
+        rescpp::stats::report report = rescpp::stats::snapshot();
+        const auto created = report.count<ParseError>(rescpp::stats::event::created);
+        const auto sites = report.sites().size();
+
+        report.merge(rescpp::stats::snapshot());
+        REQUIRE(report.count<ParseError>(rescpp::stats::event::created) == created * 2);
+        REQUIRE(report.sites().size() == sites);
+    }
+
+    SECTION("Text and JSON") {
+        static_cast<void>(parse(true));
+        const auto report = rescpp::stats::snapshot();
+
+        std::FILE* text = std::tmpfile();
+        REQUIRE(report.write_text(text));
+        std::FILE* json = std::tmpfile();
+        REQUIRE(report.write_json(json));
+
+        const auto read = [](std::FILE* file) {
+            std::string content(static_cast<std::size_t>(std::ftell(file)), '\0');
+            std::rewind(file);
+            content.resize(std::fread(content.data(), 1, content.size(), file));
+            std::fclose(file);
+            return content;
+        };
+        const std::string text_content = read(text);
+        const std::string json_content = read(json);
+
+        REQUIRE(text_content.find(" created ParseError ") != std::string::npos);
+        REQUIRE(json_content.starts_with("{\"dropped\": 0, \"sites\": ["));
+        REQUIRE(json_content.find("\"event\": \"created\", \"type\": \"ParseError\"") != std::string::npos);
+    }
+}
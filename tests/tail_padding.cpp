@@ -0,0 +1,159 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/batch.hpp>
+
+// cache entry with a constructor, 4 bytes of tail padding the flag can use
+struct Entry {
+    std::int64_t key;
+    std::int32_t hits;
+
+    Entry(std::int64_t key, std::int32_t hits)
+        : key(key), hits(hits) {}
+};
+
+// same shape as aggregate, its padding gets copied with it
+struct PlainEntry {
+    std::int64_t key;
+    std::int32_t hits;
+};
+
+struct Small {
+    std::int32_t id;
+    std::uint8_t kind;
+
+    Small(std::int32_t id, std::uint8_t kind)
+        : id(id), kind(kind) {}
+};
+
+struct Named {
+    std::string name;
+    bool pinned;
+
+    Named(std::string name, bool pinned)
+        : name(std::move(name)), pinned(pinned) {}
+};
+
+// no padding at all
+struct Pair {
+    std::int64_t first;
+    std::int64_t second;
+
+    Pair(std::int64_t first, std::int64_t second)
+        : first(first), second(second) {}
+};
+
+// mixed access, not standard layout
+class Mixed {
+    std::int64_t key_;
+
+public:
+    std::int32_t hits;
+
+    Mixed(std::int64_t key, std::int32_t hits)
+        : key_(key), hits(hits) {}
+};
+
+enum class CacheError : std::int32_t {
+    missing,
+    expired,
+};
+
+struct WideError {
+    std::int64_t code;
+    std::int32_t detail;
+};
+
+// tail padding path
+static_assert(sizeof(rescpp::result<Entry, CacheError>) == sizeof(Entry));
+static_assert(sizeof(rescpp::result<Entry, std::int64_t>) == sizeof(Entry));
+static_assert(sizeof(rescpp::result<Small, std::uint8_t>) == sizeof(Small));
+static_assert(sizeof(rescpp::result<Small, CacheError>) == sizeof(Small));
+static_assert(sizeof(rescpp::result<Named, CacheError>) == sizeof(Named));
+static_assert(std::is_trivially_copyable_v<rescpp::result<Entry, CacheError>>);
+static_assert(!std::is_trivially_copyable_v<rescpp::result<Named, CacheError>>);
+
+// tagged path
+static_assert(sizeof(rescpp::result<PlainEntry, CacheError>) == sizeof(PlainEntry) + 8);
+static_assert(sizeof(rescpp::result<Entry, WideError>) == sizeof(Entry) + 8);
+static_assert(sizeof(rescpp::result<Pair, CacheError>) == sizeof(Pair) + 8);
+static_assert(sizeof(rescpp::result<Mixed, CacheError>) == sizeof(Mixed) + 8);
+static_assert(sizeof(rescpp::result<Small, std::int64_t>) == 2 * sizeof(std::int64_t));
+
+// the batch kernels read the flag in the tail padding
+static_assert(rescpp::detail::result_layout<rescpp::result<Entry, CacheError>>::has_error_flag);
+static_assert(rescpp::detail::result_layout<rescpp::result<Entry, CacheError>>::error_flag_offset == 12);
+
+static rescpp::result<Entry, CacheError> lookup(std::int64_t key) {
+    if (key < 0) {
+        return rescpp::fail(CacheError::missing);
+    }
+    return Entry(key, 1);
+}
+
+TEST_CASE("Tail padding storage", "[tail_padding]") {
+    SECTION("Value and error") {
+        auto found = lookup(7);
+        REQUIRE_FALSE(found.has_error());
+        REQUIRE(found.value().key == 7);
+
+        auto missing = lookup(-1);
+        REQUIRE(missing.has_error());
+        REQUIRE(missing.error() == CacheError::missing);
+    }
+
+    SECTION("Writing the value keeps the flag") {
+        auto res = lookup(1);
+        res.value() = Entry(2, 3);
+        res.value().hits = -1;
+        REQUIRE_FALSE(res.has_error());
+
+        res = Entry(4, 5);
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(res.value().key == 4);
+    }
+
+    SECTION("Copy, move and assignment") {
+        auto res = lookup(1);
+        auto copy = res;
+        REQUIRE(copy.value().key == 1);
+
+        res = lookup(-1);
+        REQUIRE(res.has_error());
+        copy = res;
+        REQUIRE(copy.has_error());
+
+        copy = lookup(9);
+        REQUIRE(copy.value().key == 9);
+
+        res.emplace(11, 12);
+        REQUIRE(res.value().hits == 12);
+        res.emplace_error(CacheError::expired);
+        REQUIRE(res.error() == CacheError::expired);
+    }
+
+    SECTION("Non trivial value") {
+        rescpp::result<Named, CacheError> res(std::in_place, std::string(40, 'n'), true);
+        auto copy = res;
+        REQUIRE(copy.value().name == res.value().name);
+
+        res = rescpp::fail(CacheError::expired);
+        REQUIRE(res.has_error());
+        res = std::move(copy);
+        REQUIRE_FALSE(res.has_error());
+        REQUIRE(res.value().pinned);
+        REQUIRE(res.value().name.size() == 40);
+    }
+
+    SECTION("Batch queries") {
+        std::vector<rescpp::result<Entry, CacheError>> results;
+        for (std::int64_t i = 0; i < 100; ++i) {
+            results.push_back(lookup(i % 3 == 0 ? -1 : i));
+        }
+        REQUIRE(rescpp::count_errors(results) == 34);
+        REQUIRE(rescpp::first_error_index(results) == 0);
+    }
+}
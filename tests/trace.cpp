@@ -0,0 +1,139 @@
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <res-cpp/res-cpp.hpp>
+#include <res-cpp/coroutine.hpp>
+#include <res-cpp/trace.hpp>
+
+// compiled with 'RESCPP_ENABLE_TRACE' in its own executable
+
+static_assert(rescpp::trace::enabled);
+
+static rescpp::result<int, std::string> leaf(bool fail) {
+    if (fail) {
+        return rescpp::fail(std::string("leaf failed"));
+    }
+    return 1;
+}
+
+static rescpp::result<int, std::string> middle(bool fail) {
+    auto value = RESCPP_TRY(leaf(fail));
+    return value + 1;
+}
+
+static rescpp::result<void, std::string> top(bool fail) {
+    RESCPP_TRY_(value, middle(fail));
+    static_cast<void>(value);
+    return {};
+}
+
+static rescpp::result<int, std::string> awaiting(bool fail) {
+    auto value = co_await middle(fail);
+    co_return value + 1;
+}
+
+static rescpp::result<int, std::string> pass_on(rescpp::result<int, std::string> res) {
+    auto value = RESCPP_TRY(std::move(res));
+    return value;
+}
+
+static rescpp::result<int, std::string> await_on(rescpp::result<int, std::string> res) {
+    auto value = co_await std::move(res);
+    co_return value;
+}
+
+static std::vector<unsigned> hop_lines(std::uint64_t error) {
+    std::vector<unsigned> lines;
+    rescpp::trace::for_each_hop(error, [&lines](const rescpp::trace::hop& hop) {
+        lines.push_back(hop.location.line());
+    });
+    return lines;
+}
+
+TEST_CASE("Propagation trace", "[trace]") {
+    rescpp::trace::clear();
+
+    SECTION("Hops of an error") {
+        auto res = top(true);
+        REQUIRE(res.has_error());
+
+        const auto lines = hop_lines(rescpp::trace::current_error());
+        REQUIRE(lines == std::vector<unsigned>{ 21, 26 });
+    }
+
+    SECTION("co_await records a hop") {
+        REQUIRE(awaiting(true).has_error());
+
+        const auto lines = hop_lines(rescpp::trace::current_error());
+        REQUIRE(lines == std::vector<unsigned>{ 21, 32 });
+    }
+
+    SECTION("Success path records nothing") {
+        const auto before = rescpp::trace::current_error();
+        REQUIRE_FALSE(top(false).has_error());
+
+        REQUIRE(rescpp::trace::current_error() == before);
+        REQUIRE(hop_lines(before).empty());
+    }
+
+    SECTION("Every error gets its own id") {
+        auto first = middle(true);
+        const auto first_error = rescpp::trace::current_error();
+        auto second = top(true);
+        const auto second_error = rescpp::trace::current_error();
+
+        REQUIRE(first_error != second_error);
+        REQUIRE(hop_lines(first_error).size() == 1);
+        REQUIRE(hop_lines(second_error).size() == 2);
+    }
+
+    SECTION("Interleaved errors keep their hops") {
+        auto first = leaf(true);
+        auto second = leaf(true);
+        const auto first_error = rescpp::trace::error_id(first);
+        const auto second_error = rescpp::trace::error_id(second);
+        REQUIRE(first_error != second_error);
+
+        // the older error propagates after the newer one was created
+        first = pass_on(std::move(first));
+        second = await_on(std::move(second));
+        first = pass_on(std::move(first));
+
+        REQUIRE(rescpp::trace::error_id(first) == first_error);
+        REQUIRE(rescpp::trace::error_id(second) == second_error);
+        REQUIRE(hop_lines(first_error) == std::vector<unsigned>{ 37, 37 });
+        REQUIRE(hop_lines(second_error) == std::vector<unsigned>{ 42 });
+    }
+
+    SECTION("Conversions keep the id") {
+        auto res = leaf(true);
+        const auto id = rescpp::trace::error_id(res);
+
+        rescpp::result<long, std::string> converted = res;
+        REQUIRE(rescpp::trace::error_id(converted) == id);
+        auto chained = std::move(converted).and_then([](long value) -> rescpp::result<int, std::string> {
+            return static_cast<int>(value);
+        });
+        REQUIRE(rescpp::trace::error_id(chained) == id);
+        auto mapped = chained.transform_error([](const std::string& error) { return error.size(); });
+        REQUIRE(rescpp::trace::error_id(mapped) == id);
+
+        // errors not created with 'fail' have none
+        REQUIRE(rescpp::trace::error_id(rescpp::result<int, std::string>(rescpp::failure<std::string>("plain"))) == 0);
+        REQUIRE(rescpp::trace::error_id(leaf(false)) == 0);
+    }
+
+    SECTION("Ring buffer keeps the last hops") {
+        for (std::size_t i = 0; i < rescpp::trace::capacity; ++i) {
+            static_cast<void>(middle(true));
+        }
+        const auto last = rescpp::trace::current_error();
+        static_cast<void>(top(true));
+
+        // the oldest hop got overwritten
+        REQUIRE(hop_lines(last - rescpp::trace::capacity + 1).empty());
+        REQUIRE(hop_lines(last).size() == 1);
+        REQUIRE(hop_lines(rescpp::trace::current_error()).size() == 2);
+    }
+}
@@ -225,3 +225,126 @@ TEST_CASE("RESCPP_TRY with reference types", "[try_macro]") {
     REQUIRE(result.value() == 84);
     REQUIRE(obj.value == 84); // The original object should be modified
 }
+
+// Error type counting its copies, moves and payload allocations
+struct CountingError {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    static inline int allocations = 0;
+
+    std::string message;
+
+    static void reset() {
+        copies = 0;
+        moves = 0;
+        allocations = 0;
+    }
+
+    explicit CountingError(const char* msg)
+        : message(msg) {
+        ++allocations;
+    }
+
+    CountingError(const CountingError& other)
+        : message(other.message) {
+        ++copies;
+        ++allocations;
+    }
+
+    CountingError(CountingError&& other) noexcept
+        : message(std::move(other.message)) {
+        ++moves;
+    }
+
+    CountingError& operator=(const CountingError&) = delete;
+    CountingError& operator=(CountingError&&) = delete;
+};
+
+rescpp::result<int, CountingError> counting_leaf(bool fail) {
+    if (fail) {
+        return rescpp::fail<CountingError>("a message which does not fit into the small string buffer");
+    }
+    return 1;
+}
+
+rescpp::result<int, CountingError> counting_level_1(bool fail) {
+    auto value = RESCPP_TRY(counting_leaf(fail));
+    return value + 1;
+}
+
+rescpp::result<int, CountingError> counting_level_2(bool fail) {
+    RESCPP_TRY_(value, counting_level_1(fail));
+    return value + 1;
+}
+
+rescpp::result<int, CountingError> counting_level_3(bool fail) {
+    auto value = RESCPP_TRY(counting_level_2(fail));
+    return value + 1;
+}
+
+rescpp::result<void, CountingError> counting_void_leaf() {
+    return rescpp::fail<CountingError>("a message which does not fit into the small string buffer");
+}
+
+rescpp::result<void, CountingError> counting_void_level_1() {
+    RESCPP_TRY(counting_void_leaf());
+    return {};
+}
+
+rescpp::result<int, CountingError> counting_void_level_2() {
+    RESCPP_TRY_(_, counting_void_level_1());
+    static_cast<void>(_);
+    return 1;
+}
+
+TEST_CASE("RESCPP_TRY moves errors", "[try_macro][move]") {
+    SECTION("Void error propagation without copies") {
+        CountingError::reset();
+        auto result = counting_void_level_2();
+
+        REQUIRE(result.has_error());
+        REQUIRE(CountingError::copies == 0);
+        REQUIRE(CountingError::allocations == 1);
+    }
+
+    SECTION("Error propagation without copies") {
+        CountingError::reset();
+        auto result = counting_level_3(true);
+
+        REQUIRE(result.has_error());
+        REQUIRE(result.error().message == "a message which does not fit into the small string buffer");
+        REQUIRE(CountingError::copies == 0);
+        REQUIRE(CountingError::allocations == 1);
+        REQUIRE(CountingError::moves > 0);
+    }
+
+    SECTION("Success path does not touch the error") {
+        CountingError::reset();
+        auto result = counting_level_3(false);
+
+        REQUIRE_FALSE(result.has_error());
+        REQUIRE(result.value() == 4);
+        REQUIRE(CountingError::copies == 0);
+        REQUIRE(CountingError::allocations == 0);
+        REQUIRE(CountingError::moves == 0);
+    }
+
+    SECTION("fail() with an rvalue moves") {
+        CountingError::reset();
+        CountingError error("moved into the failure");
+        rescpp::result<int, CountingError> result = rescpp::fail(std::move(error));
+
+        REQUIRE(result.has_error());
+        REQUIRE(CountingError::copies == 0);
+        REQUIRE(CountingError::allocations == 1);
+    }
+
+    SECTION("fail() with an lvalue copies") {
+        CountingError::reset();
+        const CountingError error("copied into the failure");
+        rescpp::result<int, CountingError> result = rescpp::fail(error);
+
+        REQUIRE(result.has_error());
+        REQUIRE(CountingError::copies == 1);
+    }
+}